@@ -0,0 +1,26 @@
+// arrays of hpxc::gpu::BindlessTable
+// include this right after #version, and index the arrays with
+//   nonuniformEXT(index) where the index is given via push constants
+#extension GL_EXT_nonuniform_qualifier:require
+#ifndef BINDLESS_IMAGE_FORMAT
+#extension GL_EXT_shader_image_load_formatted:require
+#endif
+
+// set index where the table's descriptor set is bound
+#ifndef BINDLESS_SET
+#define BINDLESS_SET 0
+#endif
+
+layout(set=BINDLESS_SET,binding=0)uniform sampler2D bindless_textures[];
+// storage images of any format, this needs
+//   hpxc::gpu::Device::isStorageImageWithoutFormatSupported().
+// otherwise define BINDLESS_IMAGE_FORMAT (ex> rgba8) before including,
+//   and register storage images of that format only
+#ifdef BINDLESS_IMAGE_FORMAT
+layout(set=BINDLESS_SET,binding=1,BINDLESS_IMAGE_FORMAT)uniform image2D bindless_images[];
+#else
+layout(set=BINDLESS_SET,binding=1)uniform image2D bindless_images[];
+#endif
+layout(set=BINDLESS_SET,binding=2)buffer BindlessBuffer{
+  uint data[];
+}bindless_buffers[];
@@ -5,12 +5,22 @@ This header file is used to manage gpu commands.
 
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+
 #include "hephics_core/gpu.hpp"
 #include "hephics_core/io.hpp"
 #include "hephics_core/ui.hpp"
 
 namespace hpxc {
 
+class MipmapGenerator;
+
 struct ComputeWorkGroupSize {
   uint32_t x;
   uint32_t y;
@@ -87,6 +97,38 @@ class CommandBuffer {
                      const uint32_t offset,
                      const std::vector<float_t>& data) const;
 
+  /// <summary>
+  /// Register push constants block.
+  /// Shader stages and offset are taken from the reflected push constant
+  ///   range of the pipeline, and no memory is allocated.
+  /// In debug build, sizeof(T) is checked against the reflected size.
+  /// </summary>
+  /// <typeparam name="T">
+  ///   trivially copyable struct laid out as the shader's push_constant block
+  /// </typeparam>
+  /// <param name="pipeline"></param>
+  /// <param name="data">push constants block</param>
+  template <typename T>
+  void pushConstants(const gpu::Pipeline& pipeline, const T& data) const {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "push constants must be trivially copyable");
+
+    const auto& push_constant_range = pipeline.getPushConstantRange();
+#ifdef HEPHICS_DEBUG
+    if (sizeof(T) != push_constant_range.size) {
+      throw std::runtime_error(
+          "push constants size mismatch: sizeof(T) = " +
+          std::to_string(sizeof(T)) + ", reflected size = " +
+          std::to_string(push_constant_range.size));
+    }
+#endif
+
+    m_commandBuffer.pushConstants(pipeline.getPipelineLayout(),
+                                  push_constant_range.stageFlags,
+                                  push_constant_range.offset,
+                                  static_cast<uint32_t>(sizeof(T)), &data);
+  }
+
   /// <summary>
   /// Reset gpu commands.
   /// </summary>
@@ -128,6 +170,20 @@ class TransferCommandBuffer : public CommandBuffer {
                          const ImageLayout image_layout,
                          const ImageViewInfo& image_view_info) const;
 
+  /// <summary>
+  /// Copy cpu staging buffer data to the region of gpu image.
+  /// Buffer rows can be padded by copy_region.buffer_row_length.
+  /// </summary>
+  /// <param name="buffer">cpu buffer having image data</param>
+  /// <param name="image">gpu local image</param>
+  /// <param name="image_layout"></param>
+  /// <param name="image_view_info">mip level and array layers</param>
+  /// <param name="copy_region">offset and extent in the mip level</param>
+  void copyBufferToImage(const gpu::Buffer& buffer, const gpu::Image& image,
+                         const ImageLayout image_layout,
+                         const ImageViewInfo& image_view_info,
+                         const ImageCopyRegion& copy_region) const;
+
   /// <summary>
   /// Copy gpu image data to cpu staging buffer.
   /// </summary>
@@ -143,7 +199,23 @@ class TransferCommandBuffer : public CommandBuffer {
                          const ImageViewInfo& image_view_info) const;
 
   /// <summary>
-  /// Set mipmaps to gpu image.
+  /// Copy the region of gpu image to cpu staging buffer.
+  /// Buffer rows can be padded by copy_region.buffer_row_length.
+  /// </summary>
+  /// <param name="image">gpu local image</param>
+  /// <param name="buffer">cpu staging buffer</param>
+  /// <param name="image_layout"></param>
+  /// <param name="image_view_info">mip level and array layers</param>
+  /// <param name="copy_region">offset and extent in the mip level</param>
+  void copyImageToBuffer(const gpu::Image& image, const gpu::Buffer& buffer,
+                         const ImageLayout image_layout,
+                         const ImageViewInfo& image_view_info,
+                         const ImageCopyRegion& copy_region) const;
+
+  /// <summary>
+  /// Set mipmaps to gpu image by blit chain.
+  /// Linear filter is used if the format supports it, nearest otherwise.
+  /// Throws if the format can't be blitted (see gpu::Image::getFormatFeatures).
   /// </summary>
   /// <param name="image">image associate with mipmaps</param>
   /// <param name="dst_stage"></param>
@@ -197,8 +269,83 @@ class ComputeCommandBuffer : public TransferCommandBuffer {
   /// Triple number considered from
   ///   resource size and local_size in shader
   /// </param>
+  /// <param name="dynamic_offsets">
+  ///   byte offsets of dynamic buffers in binding order
+  ///   (ex> returned by hpxc::gpu::UniformArena::push)
+  /// </param>
   void compute(const gpu::Pipeline& pipeline,
                const gpu::DescriptorSet& descriptor_set,
+               const ComputeWorkGroupSize& work_group_size,
+               std::span<const uint32_t> dynamic_offsets = {}) const;
+
+  /// <summary>
+  /// Record descriptors into the command buffer (VK_KHR_push_descriptor).
+  /// No descriptor set is allocated or updated,
+  ///   so this is suitable for one-off dispatches.
+  /// Pipeline must be constructed with push descriptor layout,
+  ///   and its descriptors are valid until next pushDescriptors call.
+  /// </summary>
+  /// <param name="pipeline">constructed as compute pipeline</param>
+  /// <param name="buffer_descriptions"></param>
+  /// <param name="image_descriptions"></param>
+  void pushDescriptors(
+      const gpu::Pipeline& pipeline,
+      const std::vector<gpu::BufferDescription>& buffer_descriptions,
+      const std::vector<gpu::ImageDescription>& image_descriptions) const;
+
+  /// <summary>
+  /// Push all writes batched in the writer, and clear the writer.
+  /// </summary>
+  /// <param name="pipeline">constructed as compute pipeline</param>
+  /// <param name="descriptor_writer"></param>
+  void pushDescriptors(const gpu::Pipeline& pipeline,
+                       gpu::DescriptorWriter& descriptor_writer) const;
+
+  /// <summary>
+  /// Generate all mip levels of the image by one compute dispatch.
+  /// If the image is not prepared by the generator
+  ///   (see hpxc::MipmapGenerator::prepare), blit chain is used instead.
+  /// All mip levels must be TransferDstOptimal and level 0 has the data,
+  ///   same as TransferCommandBuffer::setMipmaps.
+  /// </summary>
+  /// <param name="mipmap_generator"></param>
+  /// <param name="image">image associate with mipmaps</param>
+  /// <param name="dst_stage"></param>
+  void generateMipmaps(const MipmapGenerator& mipmap_generator,
+                       const gpu::Image& image,
+                       const PipelineStage dst_stage) const;
+
+  /// <summary>
+  /// Set barriers of aliased images which begin at the pass.
+  /// Call before the pass, after previous passes are recorded.
+  /// </summary>
+  /// <param name="aliasing_planner">built planner</param>
+  /// <param name="pass_index"></param>
+  void setAliasingBarriers(const gpu::AliasingPlanner& aliasing_planner,
+                           const uint32_t pass_index) const;
+
+  /// <summary>
+  /// Bind one descriptor set at the set index of its layout.
+  /// Sets bound at other indices stay bound,
+  ///   while pipelines with compatible layouts are used,
+  ///   so only frequently changed sets need to be rebound per dispatch.
+  /// </summary>
+  /// <param name="pipeline">its layout is used for binding</param>
+  /// <param name="descriptor_set"></param>
+  /// <param name="dynamic_offsets">
+  ///   byte offsets of dynamic buffers of the set in binding order
+  /// </param>
+  void bindDescriptorSet(const gpu::Pipeline& pipeline,
+                         const gpu::DescriptorSet& descriptor_set,
+                         std::span<const uint32_t> dynamic_offsets = {}) const;
+
+  /// <summary>
+  /// Execute compute shader with descriptors already bound
+  ///   by bindDescriptorSet or pushDescriptors.
+  /// </summary>
+  /// <param name="pipeline">constructed as compute pipeline</param>
+  /// <param name="work_group_size"></param>
+  void compute(const gpu::Pipeline& pipeline,
                const ComputeWorkGroupSize& work_group_size) const;
 };
 
@@ -302,4 +449,291 @@ gpu::Buffer* createPtrUniformBuffer(
 
 using ShaderModuleMap = std::unordered_map<std::string, gpu::ShaderModule>;
 
+/// <summary>
+/// This class reloads compute shader when its source file is changed.
+/// A background thread watches the file and its included files,
+///   recompiles it by hpxc::io::shader,
+///   and builds new shader module and pipeline.
+/// The new pipeline is swapped in only at frame boundary (swapPipeline),
+///   and the replaced one is kept until in-flight frames are retired.
+/// Shader interface (descriptor bindings and push constants)
+///   must not be changed, because descriptor set layout
+///   and pipeline layout are shared with the old pipeline.
+/// </summary>
+class ShaderHotReloader {
+ private:
+  struct RetiredPipeline {
+    std::unique_ptr<gpu::ShaderModule> ptr_shader_module;
+    std::unique_ptr<gpu::Pipeline> ptr_pipeline;
+    uint64_t last_used_frame = 0U;
+  };
+
+  const std::unique_ptr<gpu::Context>& m_ptrContext;
+  const std::string m_filePath;
+  const gpu::DescriptionUnit m_descriptionUnit;
+  const gpu::DescriptorSetLayout& m_descriptorSetLayout;
+  const SpecializationValueMap m_specializationValues;
+  const std::chrono::milliseconds m_pollInterval;
+
+  std::unique_ptr<gpu::ShaderModule> m_ptrShaderModule;
+  std::unique_ptr<gpu::Pipeline> m_ptrPipeline;
+  std::vector<RetiredPipeline> m_retiredPipelines;
+
+  std::mutex m_pendingMutex;
+  std::unique_ptr<gpu::ShaderModule> m_ptrPendingShaderModule;
+  std::unique_ptr<gpu::Pipeline> m_ptrPendingPipeline;
+
+  std::mutex m_watchMutex;
+  std::condition_variable m_watchCondition;
+  bool m_isWatching = true;
+  std::thread m_watchThread;
+
+  void watch();
+  void build(std::unique_ptr<gpu::ShaderModule>& ptr_shader_module,
+             std::unique_ptr<gpu::Pipeline>& ptr_pipeline) const;
+
+ public:
+  /// <summary>
+  /// The shader is compiled once synchronously, and watching is started.
+  /// </summary>
+  /// <param name="ptr_context">must be alive longer than this object</param>
+  /// <param name="file_path">glsl compute shader file path</param>
+  /// <param name="description_unit"></param>
+  /// <param name="descriptor_set_layout">
+  ///   must be alive longer than this object
+  /// </param>
+  /// <param name="poll_interval">file watching interval</param>
+  /// <param name="specialization_values"></param>
+  ShaderHotReloader(const std::unique_ptr<gpu::Context>& ptr_context,
+                    const std::string& file_path,
+                    const gpu::DescriptionUnit& description_unit,
+                    const gpu::DescriptorSetLayout& descriptor_set_layout,
+                    const std::chrono::milliseconds poll_interval =
+                        std::chrono::milliseconds(500),
+                    const SpecializationValueMap& specialization_values = {});
+  ~ShaderHotReloader();
+
+  const auto& getPipeline() const { return *m_ptrPipeline; }
+  const auto& getShaderModule() const { return *m_ptrShaderModule; }
+
+  /// <summary>
+  /// Swap in the recompiled pipeline, if there is.
+  /// This function must be called at frame boundary,
+  ///   before recording commands of the frame.
+  /// </summary>
+  /// <param name="frame_index">
+  ///   index of the frame going to be recorded (monotonically increasing)
+  /// </param>
+  /// <returns>true: pipeline is swapped</returns>
+  bool swapPipeline(const uint64_t frame_index);
+
+  /// <summary>
+  /// Destroy replaced pipelines which are not used by gpu any longer.
+  /// </summary>
+  /// <param name="completed_frame_index">
+  ///   index of the latest frame whose gpu work is completed
+  /// </param>
+  void releaseRetiredPipelines(const uint64_t completed_frame_index);
+};
+
+/// <summary>
+/// This class generates mipmaps by single pass compute downsampler
+///   (shaders/compute/downsample.comp, after AMD FidelityFX SPD).
+/// Up to 12 levels are generated by one dispatch,
+///   so the blit and barrier chain per level is not needed.
+/// Image views, descriptor set and atomic counter are prepared per image.
+/// Supported image: 2D R8G8B8A8Unorm with Sampled and Storage usage,
+///   at most 4096 texels width and height.
+/// </summary>
+class MipmapGenerator {
+ public:
+  static constexpr uint32_t MAX_GENERATED_LEVELS = 12U;
+
+ private:
+  friend class ComputeCommandBuffer;
+
+  struct PushParams {
+    uint32_t src_width = 0U;
+    uint32_t src_height = 0U;
+    uint32_t mip_count = 0U;
+    uint32_t workgroup_count = 0U;
+  };
+
+  struct Target {
+    std::unique_ptr<gpu::ImageView> ptr_src_view;
+    std::vector<std::unique_ptr<gpu::ImageView>> ptr_mip_views;
+    std::unique_ptr<gpu::Buffer> ptr_counter_buffer;
+    std::unique_ptr<gpu::DescriptorSet> ptr_descriptor_set;
+  };
+
+  ShaderModuleMap m_shaderModuleMap;
+  std::unique_ptr<gpu::DescriptionUnit> m_ptrDescriptionUnit;
+  std::unique_ptr<gpu::DescriptorSetLayout> m_ptrDescriptorSetLayout;
+  std::unique_ptr<gpu::Pipeline> m_ptrPipeline;
+  std::unique_ptr<gpu::Sampler> m_ptrSampler;
+
+  std::unordered_map<VkImage, Target> m_targetMap;
+
+ public:
+  /// <summary>
+  /// Compile downsampler and construct its pipeline.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  /// <param name="file_path">glsl compute shader file path</param>
+  MipmapGenerator(
+      const std::unique_ptr<gpu::Context>& ptr_context,
+      const std::string& file_path = "shaders/compute/downsample.comp");
+  ~MipmapGenerator();
+
+  bool isSupported(const gpu::Image& image) const;
+
+  /// <summary>
+  /// Prepare resources to generate mipmaps of the image.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  /// <param name="image">must be alive until release is called</param>
+  /// <returns>false: not supported, blit chain is used for it</returns>
+  bool prepare(const std::unique_ptr<gpu::Context>& ptr_context,
+               const gpu::Image& image);
+
+  /// <summary>
+  /// Release resources of the image.
+  /// Gpu work using them must be completed.
+  /// </summary>
+  /// <param name="image"></param>
+  void release(const gpu::Image& image);
+};
+
+/// <summary>
+/// Settings of hpxc::TiledImageStreamer.
+/// Host images are tightly packed texels of src_format and dst_format.
+/// </summary>
+struct TileStreamInfo {
+  uint32_t tile_size = 1024U;
+  // overlap texels around a tile (ex> kernel radius of convolution)
+  uint32_t halo_size = 0U;
+  // tiles in flight, 2: upload/compute of a tile and readback of previous
+  uint32_t slot_count = 2U;
+  ImageFormat src_format = ImageFormat::R8G8B8A8Unorm;
+  ImageFormat dst_format = ImageFormat::R8G8B8A8Unorm;
+};
+
+/// <summary>
+/// A tile processed by hpxc::TiledImageStreamer.
+/// Shader reads src tile texel (src_offset_x + i, src_offset_y + j)
+///   and writes dst tile texel (i, j), for i < width and j < height.
+/// Texels of src tile out of the loaded extent are undefined.
+/// </summary>
+struct TileInfo {
+  uint32_t index = 0U;
+  uint32_t slot_index = 0U;
+  // region in host image (written back to dst host image)
+  uint32_t x = 0U;
+  uint32_t y = 0U;
+  uint32_t width = 0U;
+  uint32_t height = 0U;
+  // loaded extent of src tile (tile + halo, clamped at image edge)
+  uint32_t src_offset_x = 0U;
+  uint32_t src_offset_y = 0U;
+  uint32_t loaded_width = 0U;
+  uint32_t loaded_height = 0U;
+};
+
+/// <summary>
+/// This class streams a host image through fixed size gpu tiles,
+///   so that images larger than device memory
+///   or maxImageDimension2D can be processed.
+/// Each slot has its own tile images, staging buffers,
+///   command driver and semaphore.
+/// While gpu uploads, computes and reads back a tile,
+///   cpu scatters the previous result of the slot and gathers next tile.
+/// Tile images are General layout during compute,
+///   and descriptor sets should be made per slot in advance.
+/// </summary>
+class TiledImageStreamer {
+ public:
+  using ComputeFunction =
+      std::function<void(const ComputeCommandBuffer&, const TileInfo&)>;
+
+ private:
+  struct Slot {
+    std::unique_ptr<gpu::Image> ptr_src_image;
+    std::unique_ptr<gpu::Image> ptr_dst_image;
+    std::unique_ptr<gpu::ImageView> ptr_src_image_view;
+    std::unique_ptr<gpu::ImageView> ptr_dst_image_view;
+    std::unique_ptr<gpu::Buffer> ptr_upload_buffer;
+    std::unique_ptr<gpu::Buffer> ptr_readback_buffer;
+    std::unique_ptr<CommandDriver> ptr_command_driver;
+    std::unique_ptr<gpu::Semaphore> ptr_semaphore;
+    std::optional<TileInfo> pending_tile;
+  };
+
+  TileStreamInfo m_tileStreamInfo;
+  // byte size of one texel, derived from the formats
+  uint32_t m_srcTexelSize = 0U;
+  uint32_t m_dstTexelSize = 0U;
+  std::vector<Slot> m_slots;
+
+  void recordTileCommands(const Slot& slot, const TileInfo& tile_info,
+                          const ComputeFunction& compute_function) const;
+  void finishTile(const std::unique_ptr<gpu::Context>& ptr_context,
+                  Slot& slot, std::byte* ptr_dst, const size_t dst_row_pitch);
+
+ public:
+  /// <summary>
+  /// Allocate tile resources of all slots.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  /// <param name="tile_stream_info"></param>
+  /// <param name="src_usages">ex> Sampled for texture fetch</param>
+  /// <param name="dst_usages">ex> Storage for imageStore</param>
+  TiledImageStreamer(
+      const std::unique_ptr<gpu::Context>& ptr_context,
+      const TileStreamInfo& tile_stream_info,
+      const std::vector<ImageUsage>& src_usages = {ImageUsage::Storage},
+      const std::vector<ImageUsage>& dst_usages = {ImageUsage::Storage});
+  ~TiledImageStreamer();
+
+  const auto& getTileStreamInfo() const { return m_tileStreamInfo; }
+  auto getSlotCount() const { return static_cast<uint32_t>(m_slots.size()); }
+
+  const auto& getSrcImage(const uint32_t slot_index) const {
+    return *m_slots.at(slot_index).ptr_src_image;
+  }
+  const auto& getDstImage(const uint32_t slot_index) const {
+    return *m_slots.at(slot_index).ptr_dst_image;
+  }
+  const auto& getSrcImageView(const uint32_t slot_index) const {
+    return *m_slots.at(slot_index).ptr_src_image_view;
+  }
+  const auto& getDstImageView(const uint32_t slot_index) const {
+    return *m_slots.at(slot_index).ptr_dst_image_view;
+  }
+
+  /// <summary>
+  /// Process whole host image tile by tile, and wait for all tiles.
+  /// Row pitch is byte size of a host image row (ex> cv::Mat::step),
+  ///   and 0 means tightly packed (width * texel size).
+  /// So roi of large cv::Mat is streamed without repacking.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  /// <param name="ptr_src">src host image</param>
+  /// <param name="ptr_dst">dst host image</param>
+  /// <param name="width">host image width</param>
+  /// <param name="height">host image height</param>
+  /// <param name="compute_function">
+  ///   records compute commands of a tile
+  ///     (bind descriptor set of tile_info.slot_index and dispatch)
+  /// </param>
+  /// <param name="src_row_pitch">
+  ///   bytes per row, 0: tightly packed, less than a row throws
+  /// </param>
+  /// <param name="dst_row_pitch">same as src_row_pitch</param>
+  void stream(const std::unique_ptr<gpu::Context>& ptr_context,
+              const void* ptr_src, void* ptr_dst, const uint32_t width,
+              const uint32_t height, const ComputeFunction& compute_function,
+              const size_t src_row_pitch = 0U,
+              const size_t dst_row_pitch = 0U);
+};
+
 }  // namespace hpxc
@@ -1,8 +1,87 @@
+#include <algorithm>
+#include <array>
 #include <iostream>
 
 #include "../hephics_core.hpp"
 #include "gpu/vk_helper.hpp"
 
+// layout and access of all mip levels after mipmap generation
+static std::pair<vk::ImageLayout, vk::AccessFlags> get_mipmap_final_state(
+    const hpxc::PipelineStage dst_stage) {
+  if (dst_stage == hpxc::PipelineStage::Transfer) {
+    return {vk::ImageLayout::eTransferDstOptimal,
+            vk::AccessFlagBits::eTransferWrite};
+  }
+  if (dst_stage == hpxc::PipelineStage::BottomOfPipe) {
+    return {vk::ImageLayout::eTransferDstOptimal, vk::AccessFlags{}};
+  }
+
+  return {vk::ImageLayout::eShaderReadOnlyOptimal,
+          vk::AccessFlagBits::eShaderRead};
+}
+
+static vk::ImageMemoryBarrier get_mip_barrier(
+    const hpxc::gpu::Image& image, const uint32_t base_mip_level,
+    const uint32_t mip_levels, const vk::ImageLayout old_layout,
+    const vk::ImageLayout new_layout, const vk::AccessFlags src_access,
+    const vk::AccessFlags dst_access) {
+  vk::ImageMemoryBarrier barrier;
+  barrier.setImage(image.getImage());
+  barrier.setOldLayout(old_layout);
+  barrier.setNewLayout(new_layout);
+  barrier.setSrcAccessMask(src_access);
+  barrier.setDstAccessMask(dst_access);
+  barrier.setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED);
+  barrier.setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED);
+  barrier.setSubresourceRange(vk::ImageSubresourceRange(
+      vk::ImageAspectFlagBits::eColor, base_mip_level, mip_levels, 0U,
+      image.getArrayLayers()));
+
+  return barrier;
+}
+
+// zero extent of copy region is the rest of the mip level
+static vk::BufferImageCopy get_buffer_image_copy(
+    const hpxc::gpu::Image& image, const hpxc::ImageViewInfo& image_view_info,
+    const hpxc::ImageCopyRegion& copy_region) {
+  const auto mip_level = image_view_info.base_mip_level;
+  const auto& graphical_size = image.getGraphicalSize();
+  const auto mip_width = std::max(graphical_size.width >> mip_level, 1U);
+  const auto mip_height = std::max(graphical_size.height >> mip_level, 1U);
+  const auto mip_depth = std::max(graphical_size.depth >> mip_level, 1U);
+
+  const vk::Extent3D image_extent(
+      copy_region.width == 0U ? mip_width - copy_region.offset_x
+                              : copy_region.width,
+      copy_region.height == 0U ? mip_height - copy_region.offset_y
+                               : copy_region.height,
+      copy_region.depth == 0U ? mip_depth - copy_region.offset_z
+                              : copy_region.depth);
+
+  // 0 means tightly packed, otherwise rows must not overlap
+  if ((copy_region.buffer_row_length != 0U &&
+       copy_region.buffer_row_length < image_extent.width) ||
+      (copy_region.buffer_image_height != 0U &&
+       copy_region.buffer_image_height < image_extent.height)) {
+    throw std::runtime_error(
+        "buffer row length and image height must not be less than the "
+        "copy extent.");
+  }
+
+  vk::BufferImageCopy buffer_image_copy;
+  buffer_image_copy.setBufferOffset(copy_region.buffer_offset);
+  buffer_image_copy.setBufferRowLength(copy_region.buffer_row_length);
+  buffer_image_copy.setBufferImageHeight(copy_region.buffer_image_height);
+  buffer_image_copy.setImageSubresource(vk::ImageSubresourceLayers(
+      vk_helper::getImageAspectFlags(image_view_info.aspect), mip_level,
+      image_view_info.base_array_layer, image_view_info.array_layers));
+  buffer_image_copy.setImageOffset(vk::Offset3D(
+      copy_region.offset_x, copy_region.offset_y, copy_region.offset_z));
+  buffer_image_copy.setImageExtent(image_extent);
+
+  return buffer_image_copy;
+}
+
 void hpxc::CommandBuffer::begin(
     const CommandBeginInfo& command_begin_info) const {
   vk::CommandBufferInheritanceInfo inheritance_info;
@@ -49,7 +128,7 @@ void hpxc::CommandBuffer::pushConstants(
   }
 
   m_commandBuffer.pushConstants(
-      pipeline.getPipelineLayout().get(), vk_stages, offset,
+      pipeline.getPipelineLayout(), vk_stages, offset,
       static_cast<uint32_t>(sizeof(float_t) * data.size()), data.data());
 }
 
@@ -70,28 +149,14 @@ void hpxc::TransferCommandBuffer::copyBufferToImage(
     const gpu::Buffer& buffer, const gpu::Image& image,
     const ImageLayout image_layout,
     const ImageViewInfo& image_view_info) const {
-  vk::BufferImageCopy copy_region;
-
-  {
-    vk::ImageSubresourceLayers subresource;
-
-    subresource.setAspectMask(
-        vk_helper::getImageAspectFlags(image_view_info.aspect));
-    subresource.setMipLevel(image_view_info.base_mip_level);
-    subresource.setBaseArrayLayer(image_view_info.base_array_layer);
-    subresource.setLayerCount(image_view_info.array_layers);
-
-    copy_region.setImageSubresource(subresource);
-  }
-
-  copy_region.setImageOffset({0U, 0U, 0U});
-
-  const auto& graphical_size = image.getGraphicalSize();
-  copy_region.setBufferRowLength(graphical_size.width);
-  copy_region.setBufferImageHeight(graphical_size.height);
-  copy_region.setImageExtent(
-      {graphical_size.width, graphical_size.height, graphical_size.depth});
+  copyBufferToImage(buffer, image, image_layout, image_view_info,
+                    ImageCopyRegion{});
+}
 
+void hpxc::TransferCommandBuffer::copyBufferToImage(
+    const gpu::Buffer& buffer, const gpu::Image& image,
+    const ImageLayout image_layout, const ImageViewInfo& image_view_info,
+    const ImageCopyRegion& copy_region) const {
   vk::ImageLayout vk_image_layout = vk_helper::getImageLayout(image_layout);
   if (vk_image_layout != vk::ImageLayout::eTransferDstOptimal &&
       vk_image_layout != vk::ImageLayout::eGeneral &&
@@ -99,36 +164,23 @@ void hpxc::TransferCommandBuffer::copyBufferToImage(
     vk_image_layout = vk::ImageLayout::eTransferDstOptimal;
   }
 
-  m_commandBuffer.copyBufferToImage(buffer.getBuffer(), image.getImage(),
-                                    vk_image_layout, copy_region);
+  m_commandBuffer.copyBufferToImage(
+      buffer.getBuffer(), image.getImage(), vk_image_layout,
+      get_buffer_image_copy(image, image_view_info, copy_region));
 }
 
 void hpxc::TransferCommandBuffer::copyImageToBuffer(
     const gpu::Image& image, const gpu::Buffer& buffer,
     const ImageLayout image_layout,
     const ImageViewInfo& image_view_info) const {
-  vk::BufferImageCopy copy_region;
-
-  {
-    vk::ImageSubresourceLayers subresource;
-
-    subresource.setAspectMask(
-        vk_helper::getImageAspectFlags(image_view_info.aspect));
-    subresource.setMipLevel(image_view_info.base_mip_level);
-    subresource.setBaseArrayLayer(image_view_info.base_array_layer);
-    subresource.setLayerCount(image_view_info.array_layers);
-
-    copy_region.setImageSubresource(subresource);
-  }
-
-  copy_region.setImageOffset({0U, 0U, 0U});
-
-  const auto& graphical_size = image.getGraphicalSize();
-  copy_region.setBufferRowLength(graphical_size.width);
-  copy_region.setBufferImageHeight(graphical_size.height);
-  copy_region.setImageExtent(
-      {graphical_size.width, graphical_size.height, graphical_size.depth});
+  copyImageToBuffer(image, buffer, image_layout, image_view_info,
+                    ImageCopyRegion{});
+}
 
+void hpxc::TransferCommandBuffer::copyImageToBuffer(
+    const gpu::Image& image, const gpu::Buffer& buffer,
+    const ImageLayout image_layout, const ImageViewInfo& image_view_info,
+    const ImageCopyRegion& copy_region) const {
   vk::ImageLayout vk_image_layout = vk_helper::getImageLayout(image_layout);
   if (vk_image_layout != vk::ImageLayout::eTransferSrcOptimal &&
       vk_image_layout != vk::ImageLayout::eGeneral &&
@@ -136,102 +188,90 @@ void hpxc::TransferCommandBuffer::copyImageToBuffer(
     vk_image_layout = vk::ImageLayout::eTransferSrcOptimal;
   }
 
-  m_commandBuffer.copyImageToBuffer(image.getImage(), vk_image_layout,
-                                    buffer.getBuffer(), copy_region);
+  m_commandBuffer.copyImageToBuffer(
+      image.getImage(), vk_image_layout, buffer.getBuffer(),
+      get_buffer_image_copy(image, image_view_info, copy_region));
 }
 
 void hpxc::TransferCommandBuffer::setMipmaps(
     const gpu::Image& image, const PipelineStage dst_stage) const {
-  ImageViewInfo image_view_info{};
-  image_view_info.aspect = hpxc::ImageAspect::Color;
-  image_view_info.base_mip_level = 0U;
-  image_view_info.mip_levels = 1U;  // for sending each mip level
-  image_view_info.base_array_layer = 0U;
-  image_view_info.array_layers = 1U;
-
-  const gpu::ImageBarrier src_image_barrier(
-      image, {AccessFlag::TransferWrite}, {AccessFlag::TransferRead},
-      ImageLayout::TransferDstOptimal, ImageLayout::TransferSrcOptimal,
-      image_view_info);
-
-  const gpu::ImageBarrier dst_image_barrier(
-      image, {AccessFlag::TransferRead}, {AccessFlag::ShaderRead},
-      ImageLayout::TransferSrcOptimal, ImageLayout::ShaderReadOnlyOptimal,
-      image_view_info);
-
-  vk::ImageMemoryBarrier src_barrier = src_image_barrier.getBarrier();
-  vk::ImageMemoryBarrier dst_barrier = dst_image_barrier.getBarrier();
-
-  if (dst_stage == PipelineStage::Transfer) {
-    dst_barrier.setNewLayout(vk::ImageLayout::eTransferDstOptimal);
-    dst_barrier.setDstAccessMask(vk::AccessFlagBits::eTransferWrite);
-  }
-  if (dst_stage == PipelineStage::BottomOfPipe) {
-    dst_barrier.setNewLayout(vk::ImageLayout::eTransferDstOptimal);
+  const auto [final_layout, final_access] = get_mipmap_final_state(dst_stage);
+  const auto vk_dst_stage = vk_helper::getPipelineStageFlagBits(dst_stage);
+  const auto mip_levels = std::max(image.getMipLevels(), 1U);
+  const auto is_3d = image.getDimension() == ImageDimension::v3D;
+
+  // ex> integer formats can't be blitted with linear filter
+  const auto format_features = image.getFormatFeatures();
+  if (mip_levels > 1U &&
+      (!(format_features & vk::FormatFeatureFlagBits::eBlitSrc) ||
+       !(format_features & vk::FormatFeatureFlagBits::eBlitDst))) {
+    throw std::runtime_error("image format can't be blitted for mipmaps: " +
+                             vk::to_string(image.getFormat()));
   }
-
-  uint32_t mip_width = image.getGraphicalSize().width;
-  uint32_t mip_height = image.getGraphicalSize().height;
-
-  uint32_t mip_level = 1U;
-  for (; mip_level < image_view_info.mip_levels; mip_level += 1U) {
-    src_barrier.subresourceRange.setBaseMipLevel(mip_level - 1U);
-    m_commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
-                                    vk::PipelineStageFlagBits::eTransfer,
-                                    vk::DependencyFlagBits(0U), nullptr,
-                                    nullptr, src_barrier);
+  const auto filter =
+      format_features & vk::FormatFeatureFlagBits::eSampledImageFilterLinear
+          ? vk::Filter::eLinear
+          : vk::Filter::eNearest;
+
+  auto mip_width = static_cast<int32_t>(image.getGraphicalSize().width);
+  auto mip_height = static_cast<int32_t>(image.getGraphicalSize().height);
+  auto mip_depth =
+      is_3d ? static_cast<int32_t>(image.getGraphicalSize().depth) : 1;
+
+  // level (n - 1) is read while level n is written,
+  //   all array layers are processed by one blit
+  for (uint32_t mip_level = 1U; mip_level < mip_levels; mip_level += 1U) {
+    m_commandBuffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eTransfer,
+        vk::PipelineStageFlagBits::eTransfer, vk::DependencyFlagBits(0U),
+        nullptr, nullptr,
+        get_mip_barrier(image, mip_level - 1U, 1U,
+                        vk::ImageLayout::eTransferDstOptimal,
+                        vk::ImageLayout::eTransferSrcOptimal,
+                        vk::AccessFlagBits::eTransferWrite,
+                        vk::AccessFlagBits::eTransferRead));
+
+    const auto next_width = std::max(mip_width / 2, 1);
+    const auto next_height = std::max(mip_height / 2, 1);
+    const auto next_depth = std::max(mip_depth / 2, 1);
 
     vk::ImageBlit blit;
-    {
-      vk::ImageSubresourceLayers subresource;
-
-      subresource.setAspectMask(vk::ImageAspectFlagBits::eColor);
-      subresource.setMipLevel(mip_level - 1U);
-      subresource.setBaseArrayLayer(0U);
-      subresource.setLayerCount(1U);
-      blit.setSrcSubresource(subresource);
-      blit.setSrcOffsets({vk::Offset3D(0U, 0U, 0U),
-                          vk::Offset3D(static_cast<int32_t>(mip_width),
-                                       static_cast<int32_t>(mip_height), 1U)});
-    }
-    {
-      vk::ImageSubresourceLayers subresource;
-
-      subresource.setAspectMask(vk::ImageAspectFlagBits::eColor);
-      subresource.setMipLevel(mip_level);
-      subresource.setBaseArrayLayer(0);
-      subresource.setLayerCount(1);
-      blit.setDstSubresource(subresource);
-      blit.setDstOffsets(
-          {vk::Offset3D(0U, 0U, 0U),
-           vk::Offset3D(static_cast<int32_t>(std::max(1U, mip_width / 2U)),
-                        static_cast<int32_t>(std::max(1U, mip_height / 2U)),
-                        1U)});
-    }
+    blit.setSrcSubresource(vk::ImageSubresourceLayers(
+        vk::ImageAspectFlagBits::eColor, mip_level - 1U, 0U,
+        image.getArrayLayers()));
+    blit.setSrcOffsets({vk::Offset3D(0, 0, 0),
+                        vk::Offset3D(mip_width, mip_height, mip_depth)});
+    blit.setDstSubresource(vk::ImageSubresourceLayers(
+        vk::ImageAspectFlagBits::eColor, mip_level, 0U,
+        image.getArrayLayers()));
+    blit.setDstOffsets({vk::Offset3D(0, 0, 0),
+                        vk::Offset3D(next_width, next_height, next_depth)});
 
     m_commandBuffer.blitImage(
         image.getImage(), vk::ImageLayout::eTransferSrcOptimal,
         image.getImage(), vk::ImageLayout::eTransferDstOptimal, blit,
-        vk::Filter::eLinear);
-
-    dst_barrier.subresourceRange.setBaseMipLevel(mip_level - 1U);
+        filter);
 
+    // source level is completed
     m_commandBuffer.pipelineBarrier(
-        vk::PipelineStageFlagBits::eTransfer,
-        vk_helper::getPipelineStageFlagBits(dst_stage),
-        vk::DependencyFlagBits(0U), nullptr, nullptr, dst_barrier);
-
-    mip_width = std::max(1U, mip_width / 2U);
-    mip_height = std::max(1U, mip_height / 2U);
+        vk::PipelineStageFlagBits::eTransfer, vk_dst_stage,
+        vk::DependencyFlagBits(0U), nullptr, nullptr,
+        get_mip_barrier(image, mip_level - 1U, 1U,
+                        vk::ImageLayout::eTransferSrcOptimal, final_layout,
+                        vk::AccessFlagBits::eTransferRead, final_access));
+
+    mip_width = next_width;
+    mip_height = next_height;
+    mip_depth = next_depth;
   }
 
-  dst_barrier.subresourceRange.setBaseMipLevel(mip_level - 1);
-  dst_barrier.setOldLayout(vk::ImageLayout::eTransferDstOptimal);
-
+  // last level is only written
   m_commandBuffer.pipelineBarrier(
-      vk::PipelineStageFlagBits::eTransfer,
-      vk_helper::getPipelineStageFlagBits(dst_stage), vk::DependencyFlagBits(0),
-      nullptr, nullptr, dst_barrier);
+      vk::PipelineStageFlagBits::eTransfer, vk_dst_stage,
+      vk::DependencyFlagBits(0U), nullptr, nullptr,
+      get_mip_barrier(image, mip_levels - 1U, 1U,
+                      vk::ImageLayout::eTransferDstOptimal, final_layout,
+                      vk::AccessFlagBits::eTransferWrite, final_access));
 }
 
 void hpxc::TransferCommandBuffer::transferMipmapImages(
@@ -298,6 +338,74 @@ void hpxc::TransferCommandBuffer::acquireMipmapImages(
 
 void hpxc::ComputeCommandBuffer::compute(
     const gpu::Pipeline& pipeline, const gpu::DescriptorSet& descriptor_set,
+    const ComputeWorkGroupSize& work_group_size,
+    std::span<const uint32_t> dynamic_offsets) const {
+  if (pipeline.getQueueFamilyType() != QueueFamilyType::Compute) {
+    std::cerr << "argument pipeline is not compute pipeline." << std::endl;
+
+    return;
+  }
+
+  m_commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute,
+                               pipeline.getPipeline().get());
+  m_commandBuffer.bindDescriptorSets(
+      vk::PipelineBindPoint::eCompute, pipeline.getPipelineLayout(),
+      descriptor_set.getSetIndex(), descriptor_set.getDescriptorSet(),
+      dynamic_offsets);
+  m_commandBuffer.dispatch(work_group_size.x, work_group_size.y,
+                           work_group_size.z);
+}
+
+void hpxc::ComputeCommandBuffer::pushDescriptors(
+    const gpu::Pipeline& pipeline,
+    const std::vector<gpu::BufferDescription>& buffer_descriptions,
+    const std::vector<gpu::ImageDescription>& image_descriptions) const {
+  if (!pipeline.isPushDescriptor()) {
+    std::cerr << "argument pipeline is not for push descriptor." << std::endl;
+
+    return;
+  }
+
+  std::vector<vk::WriteDescriptorSet> write_descriptor_sets;
+  write_descriptor_sets.reserve(buffer_descriptions.size() +
+                                image_descriptions.size());
+
+  // dstSet is ignored for push descriptors
+  for (const auto& buffer_description : buffer_descriptions) {
+    write_descriptor_sets.push_back(buffer_description.getWriteDescriptorSet());
+  }
+  for (const auto& image_description : image_descriptions) {
+    write_descriptor_sets.push_back(image_description.getWriteDescriptorSet());
+  }
+
+  m_commandBuffer.pushDescriptorSetKHR(vk::PipelineBindPoint::eCompute,
+                                       pipeline.getPipelineLayout(),
+                                       *pipeline.getPushDescriptorSetIndex(),
+                                       write_descriptor_sets);
+}
+
+void hpxc::ComputeCommandBuffer::pushDescriptors(
+    const gpu::Pipeline& pipeline,
+    gpu::DescriptorWriter& descriptor_writer) const {
+  if (!pipeline.isPushDescriptor()) {
+    std::cerr << "argument pipeline is not for push descriptor." << std::endl;
+
+    return;
+  }
+  if (descriptor_writer.isEmpty()) {
+    return;
+  }
+
+  m_commandBuffer.pushDescriptorSetKHR(
+      vk::PipelineBindPoint::eCompute, pipeline.getPipelineLayout(),
+      *pipeline.getPushDescriptorSetIndex(),
+      descriptor_writer.getWriteDescriptorSets());
+
+  descriptor_writer.clear();
+}
+
+void hpxc::ComputeCommandBuffer::compute(
+    const gpu::Pipeline& pipeline,
     const ComputeWorkGroupSize& work_group_size) const {
   if (pipeline.getQueueFamilyType() != QueueFamilyType::Compute) {
     std::cerr << "argument pipeline is not compute pipeline." << std::endl;
@@ -307,9 +415,111 @@ void hpxc::ComputeCommandBuffer::compute(
 
   m_commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute,
                                pipeline.getPipeline().get());
+  m_commandBuffer.dispatch(work_group_size.x, work_group_size.y,
+                           work_group_size.z);
+}
+
+void hpxc::ComputeCommandBuffer::bindDescriptorSet(
+    const gpu::Pipeline& pipeline, const gpu::DescriptorSet& descriptor_set,
+    std::span<const uint32_t> dynamic_offsets) const {
   m_commandBuffer.bindDescriptorSets(
-      vk::PipelineBindPoint::eCompute, pipeline.getPipelineLayout().get(), 0U,
-      descriptor_set.getDescriptorSet().get(), {});
+      vk::PipelineBindPoint::eCompute, pipeline.getPipelineLayout(),
+      descriptor_set.getSetIndex(), descriptor_set.getDescriptorSet(),
+      dynamic_offsets);
+}
+
+void hpxc::ComputeCommandBuffer::generateMipmaps(
+    const MipmapGenerator& mipmap_generator, const gpu::Image& image,
+    const PipelineStage dst_stage) const {
+  const auto iter = mipmap_generator.m_targetMap.find(image.getImage());
+  if (iter == mipmap_generator.m_targetMap.end()) {
+    setMipmaps(image, dst_stage);
+
+    return;
+  }
+
+  const auto& target = iter->second;
+  const auto& pipeline = *mipmap_generator.m_ptrPipeline;
+  const auto [final_layout, final_access] = get_mipmap_final_state(dst_stage);
+  const auto mip_levels = image.getMipLevels();
+  const auto& graphical_size = image.getGraphicalSize();
+
+  // counter is cleared every time, an aborted dispatch never leaves garbage
+  const auto& counter_buffer = *target.ptr_counter_buffer;
+  m_commandBuffer.fillBuffer(counter_buffer.getBuffer(), 0U,
+                             VK_WHOLE_SIZE, 0U);
+
+  vk::BufferMemoryBarrier counter_barrier;
+  counter_barrier.setBuffer(counter_buffer.getBuffer());
+  counter_barrier.setOffset(0U);
+  counter_barrier.setSize(VK_WHOLE_SIZE);
+  counter_barrier.setSrcAccessMask(vk::AccessFlagBits::eTransferWrite);
+  counter_barrier.setDstAccessMask(vk::AccessFlagBits::eShaderRead |
+                                   vk::AccessFlagBits::eShaderWrite);
+  counter_barrier.setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED);
+  counter_barrier.setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED);
+
+  const std::array<vk::ImageMemoryBarrier, 2U> image_barriers = {
+      get_mip_barrier(image, 0U, 1U, vk::ImageLayout::eTransferDstOptimal,
+                      vk::ImageLayout::eShaderReadOnlyOptimal,
+                      vk::AccessFlagBits::eTransferWrite,
+                      vk::AccessFlagBits::eShaderRead),
+      get_mip_barrier(image, 1U, mip_levels - 1U,
+                      vk::ImageLayout::eTransferDstOptimal,
+                      vk::ImageLayout::eGeneral, vk::AccessFlags{},
+                      vk::AccessFlagBits::eShaderRead |
+                          vk::AccessFlagBits::eShaderWrite),
+  };
+  m_commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                                  vk::PipelineStageFlagBits::eComputeShader,
+                                  vk::DependencyFlagBits(0U), nullptr,
+                                  counter_barrier, image_barriers);
+
+  // a workgroup handles 64x64 texels of level 0
+  ComputeWorkGroupSize work_group_size{};
+  work_group_size.x = (graphical_size.width + 63U) / 64U;
+  work_group_size.y = (graphical_size.height + 63U) / 64U;
+  work_group_size.z = image.getArrayLayers();
+
+  MipmapGenerator::PushParams push_params{};
+  push_params.src_width = graphical_size.width;
+  push_params.src_height = graphical_size.height;
+  push_params.mip_count = mip_levels - 1U;
+  push_params.workgroup_count = work_group_size.x * work_group_size.y;
+
+  m_commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute,
+                               pipeline.getPipeline().get());
+  bindDescriptorSet(pipeline, *target.ptr_descriptor_set);
+  pushConstants(pipeline, push_params);
   m_commandBuffer.dispatch(work_group_size.x, work_group_size.y,
                            work_group_size.z);
+
+  const auto vk_dst_stage = vk_helper::getPipelineStageFlagBits(dst_stage);
+  const std::array<vk::ImageMemoryBarrier, 2U> final_barriers = {
+      get_mip_barrier(image, 0U, 1U, vk::ImageLayout::eShaderReadOnlyOptimal,
+                      final_layout, vk::AccessFlagBits::eShaderRead,
+                      final_access),
+      get_mip_barrier(image, 1U, mip_levels - 1U, vk::ImageLayout::eGeneral,
+                      final_layout, vk::AccessFlagBits::eShaderWrite,
+                      final_access),
+  };
+  m_commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader,
+                                  vk_dst_stage, vk::DependencyFlagBits(0U),
+                                  nullptr, nullptr, final_barriers);
+}
+
+void hpxc::ComputeCommandBuffer::setAliasingBarriers(
+    const gpu::AliasingPlanner& aliasing_planner,
+    const uint32_t pass_index) const {
+  const auto barriers = aliasing_planner.getAliasingBarriers(pass_index);
+  if (barriers.empty()) {
+    return;
+  }
+
+  // previous images in the same memory are written by compute or transfer
+  m_commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader |
+                                      vk::PipelineStageFlagBits::eTransfer,
+                                  vk::PipelineStageFlagBits::eComputeShader,
+                                  vk::DependencyFlagBits(0U), nullptr, nullptr,
+                                  barriers);
 }
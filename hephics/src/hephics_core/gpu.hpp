@@ -9,10 +9,19 @@ Especially, the content of this file is a driver for Vulkan API's each moudle.
 #define HEPHICS_DEBUG
 #endif
 
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <future>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <set>
 #include <shared_mutex>
+#include <span>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <variant>
 
@@ -58,6 +67,8 @@ enum class ImageUsage {
   DepthStencilAttachment,
   TransientAttachment,
   InputAttachment,
+  // VK_EXT_host_image_copy, ignored when the device or format lacks it
+  HostTransfer,
 };
 
 enum class ImageFormat {
@@ -90,6 +101,48 @@ enum class ImageFormat {
   R8G8B8A8Uint,
   R8G8B8A8Sint,
   R8G8B8A8Srgb,
+  // 16bit per channel
+  R16Unorm,
+  R16Uint,
+  R16Sint,
+  R16Sfloat,
+  R16G16Unorm,
+  R16G16Uint,
+  R16G16Sfloat,
+  R16G16B16A16Unorm,
+  R16G16B16A16Uint,
+  R16G16B16A16Sint,
+  R16G16B16A16Sfloat,
+  // 32bit per channel
+  R32Uint,
+  R32Sint,
+  R32Sfloat,
+  R32G32Uint,
+  R32G32Sfloat,
+  R32G32B32A32Uint,
+  R32G32B32A32Sint,
+  R32G32B32A32Sfloat,
+  // packed
+  A2B10G10R10Unorm,
+  B10G11R11Ufloat,
+};
+
+/// <summary>
+/// Capability of image format on the device.
+/// Float and 16bit formats aren't always usable as storage image
+///   or for linear filtering, so check them before image creation.
+/// </summary>
+enum class FormatFeature {
+  Unknown = 0U,
+  Sampled,
+  SampledLinearFilter,
+  Storage,
+  StorageAtomic,
+  ColorAttachment,
+  BlitSrc,
+  BlitDst,
+  TransferSrc,
+  TransferDst,
 };
 
 enum class ImageDimension {
@@ -237,6 +290,14 @@ enum class ShaderStage {
   Compute,
 };
 
+enum class SpecializationConstantType {
+  Unknown = 0U,
+  Bool,
+  Int,
+  UInt,
+  Float,
+};
+
 struct ImageSubInfo {
   gpu_ui_connection::GraphicalSize<uint32_t> graphical_size{};
   uint32_t mip_levels = 1U;
@@ -248,9 +309,23 @@ struct ImageSubInfo {
 
 struct DescriptorInfo {
   vk::ShaderStageFlags stage_flags{};
+  uint32_t set = 0U;
   uint32_t binding = 0U;
   vk::DescriptorType type{};
   uint32_t size = 0U;
+  // array element count (1: not array, 0: runtime array not sized yet)
+  uint32_t count = 1U;
+  bool is_runtime_array = false;
+};
+
+/// <summary>
+/// One slot of packed descriptor data
+///   for hpxc::gpu::DescriptorSet::updateDescriptorSet with update template.
+/// Only the member matching the descriptor type of the slot is read.
+/// </summary>
+struct DescriptorUpdateInfo {
+  vk::DescriptorBufferInfo buffer_info{};
+  vk::DescriptorImageInfo image_info{};
 };
 
 struct PushConstantRange {
@@ -259,6 +334,41 @@ struct PushConstantRange {
   size_t size = 0U;
 };
 
+struct SpecializationConstantInfo {
+  uint32_t constant_id = 0U;
+  uint32_t size = 0U;
+  SpecializationConstantType type{};
+};
+
+/// <summary>
+/// Specialization constant value.
+/// bool is sent as VkBool32.
+/// The alternative must match the type declared in shader
+///   (ex> layout(constant_id = 0) const uint TILE_SIZE = 8;),
+///   otherwise hpxc::gpu::Specialization throws.
+/// </summary>
+using SpecializationValue = std::variant<bool, int32_t, uint32_t, float_t>;
+
+/// <summary>
+/// key: specialization constant name in shader
+/// </summary>
+using SpecializationValueMap = std::map<std::string, SpecializationValue>;
+
+/// <summary>
+/// Shader reflection result of one spirv-binary.
+/// This is computed by spirv-cross only once,
+///   and can be serialized (see hpxc::io::shader::writeReflection),
+///   so that hpxc::gpu::ShaderModule is constructed without spirv-cross.
+/// </summary>
+struct ShaderReflection {
+  std::string entry_point_name;
+  vk::ShaderStageFlags stage_flags{};
+  std::unordered_map<std::string, DescriptorInfo> descriptor_info_map;
+  std::unordered_map<std::string, PushConstantRange> push_constant_range_map;
+  std::unordered_map<std::string, SpecializationConstantInfo>
+      specialization_constant_map;
+};
+
 /// <summary>
 /// This struct is not only for image view,
 ///   but also for image barrier, and etc...
@@ -270,6 +380,47 @@ struct ImageViewInfo {
   uint32_t base_array_layer;
   uint32_t array_layers;
   ImageAspect aspect;
+  // true: 1D or 2D array view (ex> image2DArray in shader)
+  bool is_array = false;
+};
+
+/// <summary>
+/// Region in one mip level for buffer and image copy.
+/// Zero extent means the rest of the mip level from the offset.
+/// Buffer rows may be padded (row length is at least region width).
+/// </summary>
+struct ImageCopyRegion {
+  int32_t offset_x = 0;
+  int32_t offset_y = 0;
+  int32_t offset_z = 0;
+  uint32_t width = 0U;
+  uint32_t height = 0U;
+  uint32_t depth = 0U;
+  // byte offset in buffer
+  vk::DeviceSize buffer_offset = 0U;
+  // buffer row pitch and image height in texels, 0: tightly packed
+  //   (ex> roi of cv::Mat: row length = step / elemSize()),
+  //   less than the copy extent throws
+  uint32_t buffer_row_length = 0U;
+  uint32_t buffer_image_height = 0U;
+};
+
+/// <summary>
+/// Subgroup (wave, warp) capability of the physical device.
+/// size_* members are valid only when size_control is true
+///   (VK_EXT_subgroup_size_control).
+/// </summary>
+struct SubgroupProperties {
+  uint32_t size = 0U;
+  vk::ShaderStageFlags supported_stages{};
+  vk::SubgroupFeatureFlags supported_operations{};
+  bool quad_operations_in_all_stages = false;
+
+  bool size_control = false;
+  bool compute_full_subgroups = false;
+  uint32_t min_size = 0U;
+  uint32_t max_size = 0U;
+  vk::ShaderStageFlags required_size_stages{};
 };
 
 struct SamplerInfo {
@@ -292,6 +443,11 @@ struct SamplerInfo {
 
 namespace gpu {
 
+/// <summary>
+/// Index of a resource not registered in hpxc::gpu::BindlessTable.
+/// </summary>
+constexpr uint32_t INVALID_BINDLESS_INDEX = 0xffffffffU;
+
 #ifdef HEPHICS_DEBUG
 namespace debug {
 
@@ -337,6 +493,17 @@ class Device {
     std::optional<uint32_t> present;
   } m_queueFamilyIndices;
 
+  std::set<std::string> m_enabledExtensions;
+  SubgroupProperties m_subgroupProperties{};
+  bool m_isBindlessSupported = false;
+  bool m_isHostImageCopySupported = false;
+  bool m_isStorageImageWithoutFormatSupported = false;
+  std::set<vk::ImageLayout> m_hostCopySrcLayouts;
+  std::set<vk::ImageLayout> m_hostCopyDstLayouts;
+
+  void querySubgroupProperties();
+  void queryHostImageCopyLayouts();
+
  public:
   Device(const vk::UniqueInstance& ptr_instance,
          const vk::UniqueSurfaceKHR& ptr_window_surface);
@@ -344,6 +511,92 @@ class Device {
 
   const auto& getPhysicalDevice() const { return m_physicalDevice; }
   const auto& getLogicalDevice() const { return m_ptrLogicalDevice; }
+  const auto& getSubgroupProperties() const { return m_subgroupProperties; }
+
+  /// <summary>
+  /// Descriptor indexing features for hpxc::gpu::BindlessTable
+  ///   (runtime arrays, partially bound, update after bind,
+  ///    non-uniform indexing) are enabled.
+  /// </summary>
+  bool isBindlessSupported() const { return m_isBindlessSupported; }
+
+  /// <summary>
+  /// Storage images declared without format can be read and written
+  ///   (shaderStorageImageReadWithoutFormat and WriteWithoutFormat),
+  ///   as bindless.glsl declares them by default.
+  /// </summary>
+  bool isStorageImageWithoutFormatSupported() const {
+    return m_isStorageImageWithoutFormatSupported;
+  }
+
+  /// <summary>
+  /// VK_KHR_push_descriptor is enabled,
+  ///   so descriptors can be pushed to command buffer without descriptor set.
+  /// </summary>
+  bool isPushDescriptorSupported() const {
+    return isExtensionEnabled(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+  }
+
+  /// <summary>
+  /// VK_EXT_host_image_copy is enabled,
+  ///   so optimal tiling image can be copied from/to host memory
+  ///   without staging buffer and command buffer.
+  /// </summary>
+  bool isHostImageCopySupported() const { return m_isHostImageCopySupported; }
+
+  /// <summary>
+  /// Check host image copy is supported for the format.
+  /// </summary>
+  /// <param name="format"></param>
+  /// <returns>true: image of the format can have eHostTransferEXT</returns>
+  bool isHostImageCopySupported(const vk::Format format) const;
+
+  /// <summary>
+  /// Image layouts which host image copy can read from.
+  /// </summary>
+  const auto& getHostCopySrcLayouts() const { return m_hostCopySrcLayouts; }
+
+  /// <summary>
+  /// Image layouts which host image copy can write to.
+  /// </summary>
+  const auto& getHostCopyDstLayouts() const { return m_hostCopyDstLayouts; }
+
+  /// <summary>
+  /// Optional device extensions are enabled only when they are supported.
+  /// </summary>
+  /// <param name="extension_name">ex> VK_EXT_..._EXTENSION_NAME</param>
+  /// <returns>true: the extension is enabled in the logical device</returns>
+  bool isExtensionEnabled(const std::string& extension_name) const {
+    return m_enabledExtensions.contains(extension_name);
+  }
+
+  /// <summary>
+  /// Get format features of optimal tiling image.
+  /// </summary>
+  /// <param name="format"></param>
+  /// <returns>ex> eSampledImage | eStorageImage</returns>
+  vk::FormatFeatureFlags getFormatFeatures(const vk::Format format) const;
+
+  /// <summary>
+  /// Check the image format is usable for all features
+  ///   (ex> half float storage image: {FormatFeature::Storage}).
+  /// </summary>
+  /// <param name="format"></param>
+  /// <param name="features"></param>
+  /// <returns>true: all features are supported</returns>
+  bool isFormatSupported(const ImageFormat format,
+                         const std::vector<FormatFeature>& features) const;
+
+  /// <summary>
+  /// Check subgroup operations are supported in the shader stage.
+  /// </summary>
+  /// <param name="operations">ex> eBasic | eArithmetic</param>
+  /// <param name="stage"></param>
+  /// <returns>true: all operations are supported</returns>
+  bool isSubgroupSupported(
+      const vk::SubgroupFeatureFlags operations,
+      const vk::ShaderStageFlagBits stage =
+          vk::ShaderStageFlagBits::eCompute) const;
 
   /// <summary>
   /// Search queue family index from queue family type.
@@ -398,6 +651,13 @@ class Context {
   std::shared_ptr<gpu_ui_connection::WindowSurface> m_ptrWindowSurface;
   std::unique_ptr<Device> m_ptrDevice;
 
+  // key: binding or push constant signature bytes
+  std::shared_mutex m_layoutCacheMutex;
+  std::unordered_map<std::string, vk::UniqueDescriptorSetLayout>
+      m_descriptorSetLayoutCache;
+  std::unordered_map<std::string, vk::UniquePipelineLayout>
+      m_pipelineLayoutCache;
+
   bool m_isInitialized = false;
 
  public:
@@ -410,6 +670,35 @@ class Context {
   const auto& getDevice() const { return m_ptrDevice; }
 
   bool isInitialized() const { return m_isInitialized; }
+
+  /// <summary>
+  /// Get descriptor set layout which has the bindings.
+  /// Layouts are deduplicated: the same bindings (in any order)
+  ///   return the same handle, owned by this context.
+  /// </summary>
+  /// <param name="bindings"></param>
+  /// <param name="flags">descriptor set layout create flags</param>
+  /// <param name="binding_flags">
+  ///   flags for each binding, same order as bindings (empty: none)
+  /// </param>
+  /// <returns>shared vulkan descriptor set layout</returns>
+  vk::DescriptorSetLayout getDescriptorSetLayout(
+      const std::vector<vk::DescriptorSetLayoutBinding>& bindings,
+      const vk::DescriptorSetLayoutCreateFlags flags = {},
+      const std::vector<vk::DescriptorBindingFlags>& binding_flags = {});
+
+  /// <summary>
+  /// Get pipeline layout made of the set layouts and push constant ranges.
+  /// Layouts are deduplicated like getDescriptorSetLayout,
+  ///   so pipelines of the same interface are layout compatible,
+  ///   and a descriptor set bound for one of them is valid for the others.
+  /// </summary>
+  /// <param name="set_layouts">getDescriptorSetLayout results</param>
+  /// <param name="push_constant_ranges"></param>
+  /// <returns>shared vulkan pipeline layout</returns>
+  vk::PipelineLayout getPipelineLayout(
+      const std::vector<vk::DescriptorSetLayout>& set_layouts,
+      const std::vector<vk::PushConstantRange>& push_constant_ranges);
 };
 
 /// <summary>
@@ -423,10 +712,14 @@ class Context {
 /// </summary>
 class Buffer {
  protected:
+  friend class BindlessTable;
+
   vk::UniqueDeviceMemory m_ptrMemory;
   vk::UniqueBuffer m_ptrBuffer;
   size_t m_size = 0U;
 
+  uint32_t m_bindlessIndex = INVALID_BINDLESS_INDEX;
+
  public:
   Buffer() = default;
   Buffer(const std::unique_ptr<Context>& ptr_context,
@@ -438,18 +731,26 @@ class Buffer {
     m_ptrBuffer = std::move(other.m_ptrBuffer);
     m_ptrMemory = std::move(other.m_ptrMemory);
     m_size = other.m_size;
+    m_bindlessIndex = other.m_bindlessIndex;
   }
 
   Buffer& operator=(Buffer&& other) noexcept {
     m_ptrBuffer = std::move(other.m_ptrBuffer);
     m_ptrMemory = std::move(other.m_ptrMemory);
     m_size = other.m_size;
+    m_bindlessIndex = other.m_bindlessIndex;
   }
 
   const auto& getPtrBuffer() const { return m_ptrBuffer; }
   const auto& getBuffer() const { return m_ptrBuffer.get(); }
   auto getSize() const { return m_size; }
 
+  /// <summary>
+  /// Storage buffer index in hpxc::gpu::BindlessTable
+  ///   (INVALID_BINDLESS_INDEX: not registered).
+  /// </summary>
+  auto getBindlessIndex() const { return m_bindlessIndex; }
+
   /// <summary>
   /// Get virtual address mapped gpu buffer memory.
   /// Writing or reading data in this address,
@@ -464,6 +765,90 @@ class Buffer {
   /// </summary>
   /// <param name="ptr_context"></param>
   void unmapMemory(const std::unique_ptr<Context>& ptr_context) const;
+
+  /// <summary>
+  /// Make host writes visible to gpu.
+  /// Needed while mapped, unless the memory is host coherent.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  void flushMemory(const std::unique_ptr<Context>& ptr_context) const;
+
+  /// <summary>
+  /// Make gpu writes visible to host.
+  /// Needed while mapped, unless the memory is host coherent.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  void invalidateMemory(const std::unique_ptr<Context>& ptr_context) const;
+};
+
+/// <summary>
+/// This class suballocates small uniform (or storage) data
+///   from one persistently mapped buffer.
+/// Each allocation is aligned to minUniformBufferOffsetAlignment
+///   (minStorageBufferOffsetAlignment for storage buffer),
+///   so its offset is used as dynamic offset of dynamic buffer.
+/// Thousands of dispatches can share one buffer and one descriptor set.
+/// For frames in flight, use one arena per frame,
+///   and reset it after the frame's gpu work is completed.
+/// </summary>
+class UniformArena {
+ private:
+  std::unique_ptr<Buffer> m_ptrBuffer;
+  std::byte* m_ptrMappedMemory = nullptr;
+  vk::DeviceSize m_alignment = 1U;
+  vk::DeviceSize m_offset = 0U;
+
+ public:
+  /// <summary>
+  /// Create host visible buffer and map it until destruction.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  /// <param name="size">byte size of whole arena</param>
+  /// <param name="buffer_usage">UniformBuffer or StorageBuffer</param>
+  UniformArena(const std::unique_ptr<Context>& ptr_context, const size_t size,
+               const BufferUsage buffer_usage = BufferUsage::UniformBuffer);
+  ~UniformArena();
+
+  const auto& getBuffer() const { return *m_ptrBuffer; }
+  auto getAlignment() const { return m_alignment; }
+  auto getUsedSize() const { return m_offset; }
+
+  /// <summary>
+  /// Reserve aligned range.
+  /// If the arena is full, std::runtime_error is thrown.
+  /// </summary>
+  /// <param name="size">byte size</param>
+  /// <returns>byte offset in buffer (dynamic offset)</returns>
+  uint32_t allocate(const size_t size);
+
+  /// <summary>
+  /// Copy data to aligned range.
+  /// </summary>
+  /// <param name="data">trivially copyable struct matching shader block</param>
+  /// <returns>byte offset in buffer (dynamic offset)</returns>
+  template <typename T>
+  uint32_t push(const T& data) {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "uniform data must be trivially copyable.");
+
+    const auto offset = allocate(sizeof(T));
+    std::memcpy(m_ptrMappedMemory + offset, &data, sizeof(T));
+
+    return offset;
+  }
+
+  /// <summary>
+  /// Address of allocated range for writing.
+  /// </summary>
+  /// <param name="offset">returned by allocate</param>
+  void* getMappedAddress(const uint32_t offset) const {
+    return m_ptrMappedMemory + offset;
+  }
+
+  /// <summary>
+  /// Release all allocations at once.
+  /// </summary>
+  void reset() { m_offset = 0U; }
 };
 
 /// <summary>
@@ -471,37 +856,65 @@ class Buffer {
 /// </summary>
 class Image {
  protected:
+  friend class BindlessTable;
+
   vk::UniqueDeviceMemory m_ptrMemory;
   vk::UniqueImage m_ptrImage;
 
   uint32_t m_mipLevels = 0U;
   uint32_t m_arrayLayers = 0U;
   vk::Format m_format{};
+  vk::FormatFeatureFlags m_formatFeatures{};
+  vk::ImageUsageFlags m_usageFlags{};
   ImageDimension m_dimension{};
   gpu_ui_connection::GraphicalSize<uint32_t> m_graphicalSize{};
 
+  uint32_t m_bindlessSampledIndex = INVALID_BINDLESS_INDEX;
+  uint32_t m_bindlessStorageIndex = INVALID_BINDLESS_INDEX;
+
  public:
   Image() = default;
   Image(const std::unique_ptr<Context>& ptr_context,
         const MemoryUsage memory_usage, const TransferType transfer_type,
         const std::vector<ImageUsage>& image_usages,
         const ImageSubInfo& image_sub_info);
+  /// <summary>
+  /// Constructor without memory.
+  /// Memory must be bound by bindMemory before use
+  ///   (ex> memory shared by hpxc::gpu::AliasingPlanner).
+  /// </summary>
+  Image(const std::unique_ptr<Context>& ptr_context,
+        const TransferType transfer_type,
+        const std::vector<ImageUsage>& image_usages,
+        const ImageSubInfo& image_sub_info);
   ~Image();
 
   Image(Image&& other) noexcept {
     m_ptrMemory = std::move(other.m_ptrMemory);
     m_ptrImage = std::move(other.m_ptrImage);
+    m_mipLevels = other.m_mipLevels;
+    m_arrayLayers = other.m_arrayLayers;
     m_format = other.m_format;
+    m_formatFeatures = other.m_formatFeatures;
+    m_usageFlags = other.m_usageFlags;
     m_dimension = other.m_dimension;
     m_graphicalSize = std::move(other.m_graphicalSize);
+    m_bindlessSampledIndex = other.m_bindlessSampledIndex;
+    m_bindlessStorageIndex = other.m_bindlessStorageIndex;
   }
 
   Image& operator=(Image&& other) noexcept {
     m_ptrMemory = std::move(other.m_ptrMemory);
     m_ptrImage = std::move(other.m_ptrImage);
+    m_mipLevels = other.m_mipLevels;
+    m_arrayLayers = other.m_arrayLayers;
     m_format = other.m_format;
+    m_formatFeatures = other.m_formatFeatures;
+    m_usageFlags = other.m_usageFlags;
     m_dimension = other.m_dimension;
     m_graphicalSize = std::move(other.m_graphicalSize);
+    m_bindlessSampledIndex = other.m_bindlessSampledIndex;
+    m_bindlessStorageIndex = other.m_bindlessStorageIndex;
   }
 
   const auto& getPtrImage() const { return m_ptrImage; }
@@ -509,8 +922,97 @@ class Image {
   auto getMipLevels() const { return m_mipLevels; }
   auto getArrayLayers() const { return m_arrayLayers; }
   auto getFormat() const { return m_format; }
+  /// <summary>
+  /// Optimal tiling features of the format on this device.
+  /// </summary>
+  auto getFormatFeatures() const { return m_formatFeatures; }
+  auto getUsageFlags() const { return m_usageFlags; }
   auto getDimension() const { return m_dimension; }
   const auto& getGraphicalSize() const { return m_graphicalSize; }
+
+  vk::MemoryRequirements getMemoryRequirements(
+      const std::unique_ptr<Context>& ptr_context) const;
+
+  /// <summary>
+  /// Bind external memory to the image created without memory.
+  /// The memory must outlive the image.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  /// <param name="memory"></param>
+  /// <param name="offset">aligned by memory requirements</param>
+  void bindMemory(const std::unique_ptr<Context>& ptr_context,
+                  const vk::DeviceMemory memory,
+                  const vk::DeviceSize offset) const;
+
+  /// <summary>
+  /// Image is created with eHostTransferEXT,
+  ///   so copyFromHost/copyToHost don't use staging buffer.
+  /// </summary>
+  bool isHostCopyable() const {
+    return static_cast<bool>(m_usageFlags &
+                             vk::ImageUsageFlagBits::eHostTransferEXT);
+  }
+
+  /// <summary>
+  /// Copy host memory to the subresource (one mip level, some layers).
+  /// If the image is host copyable and dst_layout is host writable,
+  ///   the copy is done by cpu (VK_EXT_host_image_copy).
+  /// Otherwise staging buffer is copied by compute queue
+  ///   (TransferDst usage is required),
+  ///   and this function waits for its completion.
+  /// Throws if size is less than the bytes the copy reads.
+  /// Previous contents of the subresource are discarded,
+  ///   and the image must not be used by gpu during the copy.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  /// <param name="ptr_data">texels of the subresource</param>
+  /// <param name="size">byte size of ptr_data including row padding</param>
+  /// <param name="image_view_info">subresource to be copied</param>
+  /// <param name="dst_layout">layout of the subresource after copy</param>
+  /// <param name="row_length">row pitch in texels, 0: tightly packed</param>
+  /// <param name="image_height">
+  ///   rows per layer in texels, 0: tightly packed
+  /// </param>
+  void copyFromHost(const std::unique_ptr<Context>& ptr_context,
+                    const void* ptr_data, const size_t size,
+                    const ImageViewInfo& image_view_info,
+                    const ImageLayout dst_layout,
+                    const uint32_t row_length = 0U,
+                    const uint32_t image_height = 0U) const;
+
+  /// <summary>
+  /// Copy the subresource (one mip level, some layers) to host memory.
+  /// Staging buffer is used like copyFromHost
+  ///   (TransferSrc usage is required),
+  ///   if src_layout isn't host readable.
+  /// Throws if size is less than the bytes the copy writes.
+  /// The layout of the subresource is unchanged.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  /// <param name="ptr_data">destination of texels</param>
+  /// <param name="size">byte size of ptr_data including row padding</param>
+  /// <param name="image_view_info">subresource to be copied</param>
+  /// <param name="src_layout">current layout of the subresource</param>
+  /// <param name="row_length">row pitch in texels, 0: tightly packed</param>
+  /// <param name="image_height">
+  ///   rows per layer in texels, 0: tightly packed
+  /// </param>
+  void copyToHost(const std::unique_ptr<Context>& ptr_context, void* ptr_data,
+                  const size_t size, const ImageViewInfo& image_view_info,
+                  const ImageLayout src_layout, const uint32_t row_length = 0U,
+                  const uint32_t image_height = 0U) const;
+
+  /// <summary>
+  /// Sampled (combined image sampler) index in hpxc::gpu::BindlessTable
+  ///   (INVALID_BINDLESS_INDEX: not registered).
+  /// </summary>
+  auto getBindlessSampledIndex() const { return m_bindlessSampledIndex; }
+
+  /// <summary>
+  /// Storage image index in hpxc::gpu::BindlessTable
+  ///   (INVALID_BINDLESS_INDEX: not registered).
+  /// </summary>
+  auto getBindlessStorageIndex() const { return m_bindlessStorageIndex; }
 };
 
 /// <summary>
@@ -519,40 +1021,61 @@ class Image {
 ///   shader descriptions are parsed and stored in this class.
 /// Spirv-cross shader reflection enabled
 ///   semi-automation of above shader handling.
+/// If the reflection is already known (ex> deserialized from file),
+///   spirv-cross is not used at all.
 /// </summary>
 class ShaderModule {
  private:
   vk::UniqueShaderModule m_ptrShaderModule;
-  std::string m_entryPointName;
-
-  std::unordered_map<std::string, DescriptorInfo> m_descriptorInfoMap;
-  std::unordered_map<std::string, PushConstantRange> m_pushConstantRangeMap;
+  ShaderReflection m_reflection;
+  // identifies the code even after the vulkan handle is reused
+  uint64_t m_spirvHash = 0U;
 
  public:
   ShaderModule() = default;
   ShaderModule(const std::unique_ptr<Context>& ptr_context,
                const std::vector<uint32_t>& spirv_binary);
+  ShaderModule(const std::unique_ptr<Context>& ptr_context,
+               const std::vector<uint32_t>& spirv_binary,
+               const ShaderReflection& reflection);
   ~ShaderModule();
 
   ShaderModule(ShaderModule&& other) noexcept {
     m_ptrShaderModule = std::move(other.m_ptrShaderModule);
-    m_entryPointName = std::move(other.m_entryPointName);
-    m_descriptorInfoMap = std::move(other.m_descriptorInfoMap);
-    m_pushConstantRangeMap = std::move(other.m_pushConstantRangeMap);
+    m_reflection = std::move(other.m_reflection);
+    m_spirvHash = other.m_spirvHash;
   };
   ShaderModule& operator=(ShaderModule&& other) noexcept {
     m_ptrShaderModule = std::move(other.m_ptrShaderModule);
-    m_entryPointName = std::move(other.m_entryPointName);
-    m_descriptorInfoMap = std::move(other.m_descriptorInfoMap);
-    m_pushConstantRangeMap = std::move(other.m_pushConstantRangeMap);
+    m_reflection = std::move(other.m_reflection);
+    m_spirvHash = other.m_spirvHash;
 
     return *this;
   };
 
   const auto& getModule() const { return m_ptrShaderModule; }
-  const auto& getEntryPointName() const { return m_entryPointName; }
-  const auto& getDescriptorInfoMap() const { return m_descriptorInfoMap; }
-  const auto& getPushConstantRangeMap() const { return m_pushConstantRangeMap; }
+  const auto& getReflection() const { return m_reflection; }
+  uint64_t getSpirvHash() const { return m_spirvHash; }
+  const auto& getEntryPointName() const {
+    return m_reflection.entry_point_name;
+  }
+  const auto& getShaderStageFlags() const { return m_reflection.stage_flags; }
+  const auto& getDescriptorInfoMap() const {
+    return m_reflection.descriptor_info_map;
+  }
+  const auto& getPushConstantRangeMap() const {
+    return m_reflection.push_constant_range_map;
+  }
+  const auto& getSpecializationConstantMap() const {
+    return m_reflection.specialization_constant_map;
+  }
+
+  /// <summary>
+  /// Parse spirv-binary with spirv-cross, only once per call.
+  /// </summary>
+  /// <param name="spirv_binary"></param>
+  /// <returns>shader reflection</returns>
+  static ShaderReflection reflect(const std::vector<uint32_t>& spirv_binary);
 };
 
 /// <summary>
@@ -567,6 +1090,8 @@ class DescriptionUnit {
   std::unordered_map<std::string, DescriptorInfo> m_descriptorInfoMap;
   std::unordered_map<std::string, PushConstantRange> m_pushConstantRangeMap;
 
+  DescriptionUnit() = default;
+
  public:
   DescriptionUnit(
       const std::unordered_map<std::string, ShaderModule>& shader_module_map,
@@ -575,6 +1100,42 @@ class DescriptionUnit {
 
   const auto& getDescriptorInfoMap() const { return m_descriptorInfoMap; }
   const auto& getPushConstantRangeMap() const { return m_pushConstantRangeMap; }
+
+  /// <summary>
+  /// Descriptor set indices used in shaders (ascending order).
+  /// </summary>
+  std::set<uint32_t> getSetIndices() const;
+
+  /// <summary>
+  /// Split descriptors by set index (layout(set = N, binding = M)).
+  /// Sets are grouped by update frequency
+  ///   (ex> set 0: global, set 1: per pass, set 2: per dispatch),
+  ///   and one hpxc::gpu::DescriptorSetLayout is constructed for each.
+  /// Push constants are not included.
+  /// </summary>
+  /// <param name="set_index"></param>
+  /// <returns>description unit having only descriptors of the set</returns>
+  DescriptionUnit getSetDescriptionUnit(const uint32_t set_index) const;
+
+  /// <summary>
+  /// Set element count of runtime descriptor array
+  ///   (ex> layout(binding = 0) uniform sampler2D textures[];).
+  /// Runtime array must be sized before hpxc::gpu::DescriptorSetLayout
+  ///   is constructed from this.
+  /// </summary>
+  /// <param name="name">descriptor name in shader</param>
+  /// <param name="count">element count (greater than 0)</param>
+  void setRuntimeArrayCount(const std::string& name, const uint32_t count);
+
+  /// <summary>
+  /// Change uniform or storage buffer to dynamic buffer
+  ///   (eUniformBufferDynamic or eStorageBufferDynamic).
+  /// Spirv has no dynamic buffer, so it is decided by application.
+  /// Dynamic buffer is bound with its block size,
+  ///   and its offset is given at hpxc::ComputeCommandBuffer::compute.
+  /// </summary>
+  /// <param name="name">descriptor name in shader</param>
+  void setDynamicBuffer(const std::string& name);
 };
 
 /// <summary>
@@ -583,16 +1144,34 @@ class DescriptionUnit {
 /// </summary>
 class BufferDescription {
  private:
-  std::shared_ptr<vk::WriteDescriptorSet> m_ptrWriteDescriptorSet{};
-  std::shared_ptr<vk::DescriptorBufferInfo> m_ptrBufferInfo{};
+  uint32_t m_binding = 0U;
+  uint32_t m_arrayElement = 0U;
+  vk::DescriptorType m_descriptorType{};
+  vk::DescriptorBufferInfo m_bufferInfo{};
 
  public:
+  /// <summary>
+  /// Constructor for uniform buffer or storage buffer
+  /// </summary>
+  /// <param name="descriptor_info"></param>
+  /// <param name="buffer"></param>
+  /// <param name="array_element">element index of descriptor array</param>
   BufferDescription(const DescriptorInfo& descriptor_info,
-                    const Buffer& buffer);
+                    const Buffer& buffer, const uint32_t array_element = 0U);
   ~BufferDescription();
 
-  const auto& getWriteDescriptorSet() const { return *m_ptrWriteDescriptorSet; }
-  const auto& getBufferInfo() const { return *m_ptrBufferInfo; }
+  /// <summary>
+  /// The returned write refers to this object's buffer info,
+  ///   so this object must be alive until the write is used.
+  /// </summary>
+  vk::WriteDescriptorSet getWriteDescriptorSet() const {
+    return vk::WriteDescriptorSet({}, m_binding, m_arrayElement, 1U,
+                                  m_descriptorType, nullptr, &m_bufferInfo);
+  }
+  const auto getBinding() const { return m_binding; }
+  const auto getArrayElement() const { return m_arrayElement; }
+  const auto getDescriptorType() const { return m_descriptorType; }
+  const auto& getBufferInfo() const { return m_bufferInfo; }
 };
 
 /// <summary>
@@ -615,6 +1194,191 @@ class ImageView {
   const auto& getImageViewInfo() const { return *m_ptrImageViewInfo; }
 };
 
+/// <summary>
+/// This class recycles transient images and their views.
+/// Intermediate images of multi-pass pipeline are acquired per frame,
+///   and released with the timeline value of their last use.
+/// A released image is reused by the same creation parameters
+///   after the value is retired (see retire),
+///   so steady-state frames create no image.
+/// This class is thread-safe.
+/// </summary>
+class ImagePool {
+ public:
+  struct PooledImage {
+    std::unique_ptr<Image> ptr_image;
+    // whole image view (all mip levels and array layers)
+    std::unique_ptr<ImageView> ptr_image_view;
+  };
+
+ private:
+  struct ImageKey {
+    uint32_t width = 0U;
+    uint32_t height = 0U;
+    uint32_t depth = 0U;
+    uint32_t mip_levels = 0U;
+    uint32_t array_layers = 0U;
+    ImageSampleCount samples{};
+    ImageFormat format{};
+    ImageDimension dimension{};
+    MemoryUsage memory_usage{};
+    TransferType transfer_type{};
+    // bit (1 << ImageUsage)
+    uint32_t usage_bits = 0U;
+
+    auto operator<=>(const ImageKey&) const = default;
+  };
+
+  struct ReleasedImage {
+    PooledImage pooled_image;
+    uint64_t last_use_value = 0U;
+  };
+
+  mutable std::mutex m_mutex;
+  std::map<ImageKey, std::vector<ReleasedImage>> m_releasedImageMap;
+  std::unordered_map<VkImage, std::pair<ImageKey, PooledImage>> m_usedImageMap;
+  uint64_t m_retiredValue = 0U;
+  size_t m_createdImageCount = 0U;
+
+ public:
+  ImagePool() {}
+  ~ImagePool();
+
+  /// <summary>
+  /// Take a retired image with the same parameters, or create new one.
+  /// Pooled view is color view, so depth stencil usage throws.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  /// <param name="memory_usage"></param>
+  /// <param name="transfer_type"></param>
+  /// <param name="image_usages"></param>
+  /// <param name="image_sub_info"></param>
+  /// <returns>valid until release</returns>
+  const PooledImage& acquire(const std::unique_ptr<Context>& ptr_context,
+                             const MemoryUsage memory_usage,
+                             const TransferType transfer_type,
+                             const std::vector<ImageUsage>& image_usages,
+                             const ImageSubInfo& image_sub_info);
+
+  /// <summary>
+  /// Return the image to this pool.
+  /// Its contents are undefined when it is acquired again.
+  /// </summary>
+  /// <param name="image">image acquired from this pool</param>
+  /// <param name="last_use_value">
+  ///   timeline value signaled after the last gpu use of the image
+  /// </param>
+  void release(const Image& image, const uint64_t last_use_value);
+
+  /// <summary>
+  /// Gpu work up to completed_value is finished,
+  ///   so images released with the value or less can be reused.
+  /// </summary>
+  /// <param name="completed_value"></param>
+  void retire(const uint64_t completed_value);
+
+  /// <summary>
+  /// Destroy retired images not in use (ex> after resolution change).
+  /// </summary>
+  void trim();
+
+  /// <summary>
+  /// Total count of images created by this pool.
+  /// It stops increasing in steady state.
+  /// </summary>
+  size_t getCreatedImageCount() const;
+};
+
+/// <summary>
+/// This class shares memory among intermediate images
+///   whose lifetimes (pass ranges) don't overlap.
+/// Images are declared with first and last pass index,
+///   and build packs them into memory blocks by interval coloring:
+///   larger images first, and each image takes the first block
+///   where no placed image's pass range overlaps.
+/// An image may have contents of another image at its first pass,
+///   so it is transitioned from Undefined by aliasing barriers
+///   (see hpxc::ComputeCommandBuffer::setAliasingBarriers).
+/// </summary>
+class AliasingPlanner {
+ private:
+  struct Resource {
+    std::unique_ptr<Image> ptr_image;
+    std::unique_ptr<ImageView> ptr_image_view;
+    uint32_t first_pass = 0U;
+    uint32_t last_pass = 0U;
+    vk::MemoryRequirements memory_requirements{};
+    uint32_t block_index = 0U;
+  };
+
+  struct MemoryBlock {
+    vk::UniqueDeviceMemory ptr_memory;
+    vk::DeviceSize size = 0U;
+    uint32_t memory_type_bits = 0U;
+    std::vector<size_t> resource_indices;
+  };
+
+  // images are destroyed before the memory they are bound to
+  std::vector<MemoryBlock> m_memoryBlocks;
+  std::vector<Resource> m_resources;
+  std::map<uint32_t, std::vector<vk::ImageMemoryBarrier>> m_passBarrierMap;
+  bool m_isBuilt = false;
+
+ public:
+  AliasingPlanner() {}
+  ~AliasingPlanner();
+
+  /// <summary>
+  /// Declare an intermediate image.
+  /// Its memory is gpu only, and bound at build.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  /// <param name="transfer_type"></param>
+  /// <param name="image_usages"></param>
+  /// <param name="image_sub_info"></param>
+  /// <param name="first_pass">pass index of the first write</param>
+  /// <param name="last_pass">pass index of the last read</param>
+  /// <returns>resource index</returns>
+  size_t addImage(const std::unique_ptr<Context>& ptr_context,
+                  const TransferType transfer_type,
+                  const std::vector<ImageUsage>& image_usages,
+                  const ImageSubInfo& image_sub_info,
+                  const uint32_t first_pass, const uint32_t last_pass);
+
+  /// <summary>
+  /// Assign images to memory blocks, allocate and bind the blocks.
+  /// Image views and aliasing barriers are also made here.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  void build(const std::unique_ptr<Context>& ptr_context);
+
+  const Image& getImage(const size_t resource_index) const {
+    return *m_resources.at(resource_index).ptr_image;
+  }
+  const ImageView& getImageView(const size_t resource_index) const {
+    return *m_resources.at(resource_index).ptr_image_view;
+  }
+
+  /// <summary>
+  /// Barriers of images beginning at the pass
+  ///   (Undefined to General, after previous passes' writes).
+  /// </summary>
+  /// <param name="pass_index"></param>
+  /// <returns>empty: no image begins at the pass</returns>
+  std::span<const vk::ImageMemoryBarrier> getAliasingBarriers(
+      const uint32_t pass_index) const;
+
+  /// <summary>
+  /// Memory size allocated by build.
+  /// </summary>
+  vk::DeviceSize getAllocatedSize() const;
+
+  /// <summary>
+  /// Memory size if no image is aliased.
+  /// </summary>
+  vk::DeviceSize getUnaliasedSize() const;
+};
+
 /// <summary>
 /// This class is vulkan sampler wrapper.
 /// Sampler is used to
@@ -639,8 +1403,10 @@ class Sampler {
 /// </summary>
 class ImageDescription {
  private:
-  std::shared_ptr<vk::WriteDescriptorSet> m_ptrWriteDescriptorSet;
-  std::shared_ptr<vk::DescriptorImageInfo> m_ptrImageInfo;
+  uint32_t m_binding = 0U;
+  uint32_t m_arrayElement = 0U;
+  vk::DescriptorType m_descriptorType{};
+  vk::DescriptorImageInfo m_imageInfo{};
 
  public:
   /// <summary>
@@ -649,17 +1415,21 @@ class ImageDescription {
   /// <param name="descriptor_info"></param>
   /// <param name="image_view"></param>
   /// <param name="dst_image_layout"></param>
+  /// <param name="array_element">element index of descriptor array</param>
   ImageDescription(const DescriptorInfo& descriptor_info,
                    const ImageView& image_view,
-                   const ImageLayout dst_image_layout);
+                   const ImageLayout dst_image_layout,
+                   const uint32_t array_element = 0U);
   /// <summary>
   /// Constructor for Sampler
   /// </summary>
   /// <param name="descriptor_info"></param>
   /// <param name="dst_image_layout"></param>
   /// <param name="sampler"></param>
+  /// <param name="array_element">element index of descriptor array</param>
   ImageDescription(const DescriptorInfo& descriptor_info,
-                   const ImageLayout dst_image_layout, const Sampler& sampler);
+                   const ImageLayout dst_image_layout, const Sampler& sampler,
+                   const uint32_t array_element = 0U);
   /// <summary>
   /// Constructor for Combined Image Sampler
   /// </summary>
@@ -667,13 +1437,25 @@ class ImageDescription {
   /// <param name="image_view"></param>
   /// <param name="dst_image_layout"></param>
   /// <param name="sampler"></param>
+  /// <param name="array_element">element index of descriptor array</param>
   ImageDescription(const DescriptorInfo& descriptor_info,
                    const ImageView& image_view,
-                   const ImageLayout dst_image_layout, const Sampler& sampler);
+                   const ImageLayout dst_image_layout, const Sampler& sampler,
+                   const uint32_t array_element = 0U);
   ~ImageDescription();
 
-  const auto& getWriteDescriptorSet() const { return *m_ptrWriteDescriptorSet; }
-  const auto& getImageInfo() const { return *m_ptrImageInfo; }
+  /// <summary>
+  /// The returned write refers to this object's image info,
+  ///   so this object must be alive until the write is used.
+  /// </summary>
+  vk::WriteDescriptorSet getWriteDescriptorSet() const {
+    return vk::WriteDescriptorSet({}, m_binding, m_arrayElement, 1U,
+                                  m_descriptorType, &m_imageInfo);
+  }
+  const auto getBinding() const { return m_binding; }
+  const auto getArrayElement() const { return m_arrayElement; }
+  const auto getDescriptorType() const { return m_descriptorType; }
+  const auto& getImageInfo() const { return m_imageInfo; }
 };
 
 /// <summary>
@@ -687,21 +1469,158 @@ class ImageDescription {
 /// </summary>
 class DescriptorSetLayout {
  private:
-  vk::UniqueDescriptorSetLayout m_ptrDescriptorSetLayout;
+  // owned by hpxc::gpu::Context (shared between the same bindings)
+  vk::DescriptorSetLayout m_descriptorSetLayout;
+  uint32_t m_setIndex = 0U;
+  vk::DescriptorSetLayoutCreateFlags m_createFlags{};
   std::vector<vk::DescriptorPoolSize> m_descriptorPoolSizes;
+  // count of the runtime array at the highest binding (0: none)
+  uint32_t m_variableDescriptorCount = 0U;
+
+  // created only from reflected bindings (not for push descriptor layout)
+  vk::UniqueDescriptorUpdateTemplate m_ptrDescriptorUpdateTemplate;
+  // key: descriptor name, value: slot index in DescriptorUpdateInfo array
+  std::unordered_map<std::string, uint32_t> m_updateSlotMap;
+  uint32_t m_updateSlotCount = 0U;
+
+  void constructDescriptorUpdateTemplate(
+      const std::unique_ptr<Context>& ptr_context,
+      const DescriptionUnit& description_unit);
 
  public:
+  /// <summary>
+  /// Constructor from shader reflection.
+  /// All descriptors of the unit must be in one set,
+  ///   so use DescriptionUnit::getSetDescriptionUnit for multiple sets.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  /// <param name="description_unit"></param>
+  /// <param name="is_push_descriptor">
+  ///   true: layout for hpxc::ComputeCommandBuffer::pushDescriptors,
+  ///     no hpxc::gpu::DescriptorSet can be allocated with it
+  /// </param>
   DescriptorSetLayout(const std::unique_ptr<Context>& ptr_context,
-                      const DescriptionUnit& description_unit);
+                      const DescriptionUnit& description_unit,
+                      const bool is_push_descriptor = false);
+
+  /// <summary>
+  /// Constructor from explicit bindings (ex> bindless descriptor arrays).
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  /// <param name="bindings"></param>
+  /// <param name="binding_flags">
+  ///   flags for each binding, same order as bindings (empty: none)
+  /// </param>
+  /// <param name="flags">descriptor set layout create flags</param>
+  DescriptorSetLayout(
+      const std::unique_ptr<Context>& ptr_context,
+      const std::vector<vk::DescriptorSetLayoutBinding>& bindings,
+      const std::vector<vk::DescriptorBindingFlags>& binding_flags = {},
+      const vk::DescriptorSetLayoutCreateFlags flags = {});
   ~DescriptorSetLayout();
 
-  const auto& getDescriptorSetLayout() const {
-    return m_ptrDescriptorSetLayout;
+  const auto& getDescriptorSetLayout() const { return m_descriptorSetLayout; }
+  auto getSetIndex() const { return m_setIndex; }
+  bool isPushDescriptor() const {
+    return static_cast<bool>(
+        m_createFlags &
+        vk::DescriptorSetLayoutCreateFlagBits::ePushDescriptorKHR);
+  }
+
+  /// <summary>
+  /// Descriptor count allocated for the variable count binding
+  ///   (0: the layout has no variable count binding).
+  /// </summary>
+  auto getVariableDescriptorCount() const { return m_variableDescriptorCount; }
+
+  const auto& getDescriptorUpdateTemplate() const {
+    return m_ptrDescriptorUpdateTemplate;
+  }
+
+  /// <summary>
+  /// Slots are ordered by binding number.
+  /// Elements of descriptor array use consecutive slots from this.
+  /// </summary>
+  /// <param name="name">descriptor name in shader</param>
+  /// <returns>index in DescriptorUpdateInfo array</returns>
+  uint32_t getUpdateSlot(const std::string& name) const {
+    return m_updateSlotMap.at(name);
   }
+  size_t getUpdateSlotCount() const { return m_updateSlotCount; }
 
   vk::DescriptorPoolCreateInfo getDescriptorPoolInfo() const;
 };
 
+/// <summary>
+/// This class allocates descriptor sets from shared large pools.
+/// When the current pool runs out, another pool is taken,
+///   and pools grow up to a limit.
+/// Sets are not freed one by one: resetPools returns all of them at once,
+///   so transient sets can be allocated per dispatch.
+/// For frames in flight, use one allocator per frame,
+///   and reset it after the frame's gpu work is completed.
+/// </summary>
+class DescriptorAllocator {
+ public:
+  /// <summary>
+  /// Descriptor count of the type per one descriptor set.
+  /// </summary>
+  struct PoolSizeRatio {
+    vk::DescriptorType type{};
+    float_t ratio = 1.0f;
+  };
+
+ private:
+  std::vector<PoolSizeRatio> m_poolSizeRatios;
+  uint32_t m_setsPerPool = 0U;
+  uint32_t m_maxSetsPerPool = 0U;
+
+  std::mutex m_mutex;
+  vk::DescriptorPool m_currentPool;
+  std::vector<vk::UniqueDescriptorPool> m_ptrUsedPools;
+  std::vector<vk::UniqueDescriptorPool> m_ptrReadyPools;
+
+  vk::DescriptorPool takePool(const std::unique_ptr<Context>& ptr_context);
+
+ public:
+  /// <summary>
+  /// The first pool is created here.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  /// <param name="initial_sets_per_pool">max sets of the first pool</param>
+  /// <param name="pool_size_ratios">
+  ///   descriptor counts per set (empty: storage/uniform buffers and images)
+  /// </param>
+  /// <param name="max_sets_per_pool">new pools double up to this</param>
+  DescriptorAllocator(const std::unique_ptr<Context>& ptr_context,
+                      const uint32_t initial_sets_per_pool = 64U,
+                      const std::vector<PoolSizeRatio>& pool_size_ratios = {},
+                      const uint32_t max_sets_per_pool = 4096U);
+  ~DescriptorAllocator();
+
+  /// <summary>
+  /// Allocate a descriptor set.
+  /// The set is valid until resetPools or destruction of this object.
+  /// This function is thread-safe.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  /// <param name="descriptor_set_layout"></param>
+  /// <returns>vulkan descriptor set</returns>
+  vk::DescriptorSet allocate(const std::unique_ptr<Context>& ptr_context,
+                             const DescriptorSetLayout& descriptor_set_layout);
+
+  /// <summary>
+  /// Reset all pools, and all allocated sets are invalidated.
+  /// Gpu commands using the sets must be completed.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  void resetPools(const std::unique_ptr<Context>& ptr_context);
+
+  size_t getPoolCount() const {
+    return m_ptrUsedPools.size() + m_ptrReadyPools.size();
+  }
+};
+
 /// <summary>
 /// This class is vulkan descriptor set wrapper.
 /// DescriptorSet is actually used to bind shader resource in gpu.
@@ -709,15 +1628,29 @@ class DescriptorSetLayout {
 /// </summary>
 class DescriptorSet {
  private:
+  // empty, if the set is allocated by hpxc::gpu::DescriptorAllocator
   vk::UniqueDescriptorPool m_ptrDescriptorPool;
-  vk::UniqueDescriptorSet m_ptrDescriptorSet;
+  vk::DescriptorSet m_descriptorSet;
+  uint32_t m_setIndex = 0U;
 
  public:
   DescriptorSet(const std::unique_ptr<Context>& ptr_context,
                 const DescriptorSetLayout& description_set_layout);
+
+  /// <summary>
+  /// Allocate from the shared pools of the allocator.
+  /// This object must not be used after the allocator's resetPools.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  /// <param name="descriptor_allocator"></param>
+  /// <param name="description_set_layout"></param>
+  DescriptorSet(const std::unique_ptr<Context>& ptr_context,
+                DescriptorAllocator& descriptor_allocator,
+                const DescriptorSetLayout& description_set_layout);
   ~DescriptorSet();
 
-  const auto& getDescriptorSet() const { return m_ptrDescriptorSet; }
+  const auto& getDescriptorSet() const { return m_descriptorSet; }
+  auto getSetIndex() const { return m_setIndex; }
 
   /// <summary>
   /// Upload binding resources information to gpu.
@@ -735,6 +1668,23 @@ class DescriptorSet {
       const std::vector<BufferDescription>& buffer_descriptions,
       const std::vector<ImageDescription>& image_descriptions);
 
+  /// <summary>
+  /// Upload binding resources information with descriptor update template.
+  /// All bindings are written by one call without building write structures,
+  ///   so this is suitable for frequently rebound sets.
+  /// update_infos can be kept by caller and reused between calls.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  /// <param name="descriptor_set_layout">
+  ///   layout this set is allocated with
+  /// </param>
+  /// <param name="update_infos">
+  ///   indexed by DescriptorSetLayout::getUpdateSlot
+  /// </param>
+  void updateDescriptorSet(const std::unique_ptr<Context>& ptr_context,
+                           const DescriptorSetLayout& descriptor_set_layout,
+                           std::span<const DescriptorUpdateInfo> update_infos);
+
   /// <summary>
   /// Free gpu memory for descriptor set
   ///   for next updateDescriptorSet function call.
@@ -742,11 +1692,255 @@ class DescriptorSet {
   ///   if you want to change image resource data
   ///     without changing shader module or description unit,
   ///   this function is very useful and ecological for gpu memory.
+  /// A set allocated by hpxc::gpu::DescriptorAllocator is not freed here,
+  ///   it is returned by resetPools.
   /// </summary>
   /// <param name="ptr_context"></param>
   void freeDescriptorSet(const std::unique_ptr<Context>& ptr_context);
 };
 
+/// <summary>
+/// This class batches descriptor writes without heap allocation per write.
+/// Buffer and image infos are stored contiguously in a fixed capacity arena,
+///   so their pointers are stable until flush (or clear).
+/// Capacity is reserved once in constructor,
+///   and exceeding it throws std::runtime_error.
+/// For frames in flight, use one writer per frame.
+/// </summary>
+class DescriptorWriter {
+ private:
+  std::vector<vk::DescriptorBufferInfo> m_bufferInfos;
+  std::vector<vk::DescriptorImageInfo> m_imageInfos;
+  std::vector<vk::WriteDescriptorSet> m_writeDescriptorSets;
+
+  vk::WriteDescriptorSet& addWrite(const uint32_t binding,
+                                   const vk::DescriptorType descriptor_type,
+                                   const uint32_t array_element = 0U,
+                                   const uint32_t descriptor_count = 1U);
+
+ public:
+  /// <summary>
+  /// Reserve the arena.
+  /// </summary>
+  /// <param name="max_buffer_infos">buffer writes until flush</param>
+  /// <param name="max_image_infos">image writes until flush</param>
+  DescriptorWriter(const size_t max_buffer_infos = 64U,
+                   const size_t max_image_infos = 64U);
+  ~DescriptorWriter();
+
+  const auto& getWriteDescriptorSets() const { return m_writeDescriptorSets; }
+  bool isEmpty() const { return m_writeDescriptorSets.empty(); }
+
+  /// <summary>
+  /// Write buffer (uniform or storage buffer).
+  /// </summary>
+  /// <param name="descriptor_info"></param>
+  /// <param name="buffer"></param>
+  /// <param name="offset">byte offset in buffer</param>
+  /// <param name="range">
+  ///   byte range (VK_WHOLE_SIZE: until end of buffer)
+  /// </param>
+  void writeBuffer(const DescriptorInfo& descriptor_info, const Buffer& buffer,
+                   const vk::DeviceSize offset = 0U,
+                   const vk::DeviceSize range = VK_WHOLE_SIZE);
+
+  /// <summary>
+  /// Write image, storage image, sampler, or combined image sampler.
+  /// </summary>
+  /// <param name="descriptor_info"></param>
+  /// <param name="ptr_image_view">nullptr for sampler</param>
+  /// <param name="dst_image_layout"></param>
+  /// <param name="ptr_sampler">nullptr for image or storage image</param>
+  void writeImage(const DescriptorInfo& descriptor_info,
+                  const ImageView* ptr_image_view,
+                  const ImageLayout dst_image_layout,
+                  const Sampler* ptr_sampler = nullptr);
+
+  /// <summary>
+  /// Write consecutive elements of buffer array by one write.
+  /// </summary>
+  /// <param name="descriptor_info"></param>
+  /// <param name="ptr_buffers">whole range of each buffer is bound</param>
+  /// <param name="first_array_element"></param>
+  void writeBuffers(const DescriptorInfo& descriptor_info,
+                    std::span<const Buffer* const> ptr_buffers,
+                    const uint32_t first_array_element = 0U);
+
+  /// <summary>
+  /// Write consecutive elements of image array by one write
+  ///   (ex> frames of a batch processed by one dispatch).
+  /// </summary>
+  /// <param name="descriptor_info"></param>
+  /// <param name="ptr_image_views"></param>
+  /// <param name="dst_image_layout"></param>
+  /// <param name="ptr_sampler">nullptr for image or storage image</param>
+  /// <param name="first_array_element"></param>
+  void writeImages(const DescriptorInfo& descriptor_info,
+                   std::span<const ImageView* const> ptr_image_views,
+                   const ImageLayout dst_image_layout,
+                   const Sampler* ptr_sampler = nullptr,
+                   const uint32_t first_array_element = 0U);
+
+  void write(const BufferDescription& buffer_description);
+  void write(const ImageDescription& image_description);
+
+  /// <summary>
+  /// Update the descriptor set by one call, and clear this writer.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  /// <param name="descriptor_set">destination of all writes</param>
+  void flush(const std::unique_ptr<Context>& ptr_context,
+             const DescriptorSet& descriptor_set);
+
+  /// <summary>
+  /// Discard writes. Capacity is kept.
+  /// </summary>
+  void clear();
+};
+
+/// <summary>
+/// This class is global bindless resource table (opt-in).
+/// Its one descriptor set has large arrays of
+///   combined image samplers, storage images, and storage buffers.
+/// The arrays are partially bound and updated after bind,
+///   so resources are registered even while the set is bound.
+/// Registered image or buffer keeps a stable index,
+///   and shaders take the index via push constants.
+///   ex> layout(set = 0, binding = 0) uniform sampler2D textures[];
+///       texture(textures[nonuniformEXT(push.texture_index)], uv);
+/// hpxc::gpu::Device::isBindlessSupported() must be true.
+/// Storage images are declared without format in bindless.glsl,
+///   which needs Device::isStorageImageWithoutFormatSupported(),
+///   otherwise define BINDLESS_IMAGE_FORMAT and register that format only.
+/// </summary>
+class BindlessTable {
+ public:
+  static constexpr uint32_t SAMPLED_IMAGE_BINDING = 0U;
+  static constexpr uint32_t STORAGE_IMAGE_BINDING = 1U;
+  static constexpr uint32_t STORAGE_BUFFER_BINDING = 2U;
+
+ private:
+  struct IndexAllocator {
+    uint32_t capacity = 0U;
+    uint32_t next_index = 0U;
+    std::vector<uint32_t> free_indices;
+
+    uint32_t allocate();
+    void release(const uint32_t index);
+  };
+
+  std::unique_ptr<DescriptorSetLayout> m_ptrDescriptorSetLayout;
+  std::unique_ptr<DescriptorSet> m_ptrDescriptorSet;
+
+  std::mutex m_mutex;
+  IndexAllocator m_sampledImageIndices;
+  IndexAllocator m_storageImageIndices;
+  IndexAllocator m_storageBufferIndices;
+
+ public:
+  /// <summary>
+  /// Capacities must be within the update-after-bind descriptor limits
+  ///   of the device (per set and per stage), otherwise this throws.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  /// <param name="sampled_image_capacity"></param>
+  /// <param name="storage_image_capacity"></param>
+  /// <param name="storage_buffer_capacity"></param>
+  BindlessTable(const std::unique_ptr<Context>& ptr_context,
+                const uint32_t sampled_image_capacity = 4096U,
+                const uint32_t storage_image_capacity = 1024U,
+                const uint32_t storage_buffer_capacity = 4096U);
+  ~BindlessTable();
+
+  const auto& getDescriptorSetLayout() const {
+    return *m_ptrDescriptorSetLayout;
+  }
+  const auto& getDescriptorSet() const { return *m_ptrDescriptorSet; }
+
+  /// <summary>
+  /// Register image as combined image sampler.
+  /// If the image is already registered, its index is rewritten.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  /// <param name="image"></param>
+  /// <param name="image_view">view of the image</param>
+  /// <param name="sampler"></param>
+  /// <param name="image_layout">image layout when shaders read it</param>
+  /// <returns>index in SAMPLED_IMAGE_BINDING array</returns>
+  uint32_t registerSampledImage(
+      const std::unique_ptr<Context>& ptr_context, Image& image,
+      const ImageView& image_view, const Sampler& sampler,
+      const ImageLayout image_layout = ImageLayout::ShaderReadOnlyOptimal);
+
+  /// <summary>
+  /// Register image as storage image (image layout: General).
+  /// If the image is already registered, its index is rewritten.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  /// <param name="image"></param>
+  /// <param name="image_view">view of the image</param>
+  /// <returns>index in STORAGE_IMAGE_BINDING array</returns>
+  uint32_t registerStorageImage(const std::unique_ptr<Context>& ptr_context,
+                                Image& image, const ImageView& image_view);
+
+  /// <summary>
+  /// Register whole buffer as storage buffer.
+  /// If the buffer is already registered, its index is rewritten.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  /// <param name="buffer"></param>
+  /// <returns>index in STORAGE_BUFFER_BINDING array</returns>
+  uint32_t registerStorageBuffer(const std::unique_ptr<Context>& ptr_context,
+                                 Buffer& buffer);
+
+  /// <summary>
+  /// Release indices of the image.
+  /// Released index is reused by next registration,
+  ///   so gpu commands using it must be completed.
+  /// </summary>
+  /// <param name="image"></param>
+  void unregister(Image& image);
+
+  /// <summary>
+  /// Release index of the buffer.
+  /// Released index is reused by next registration,
+  ///   so gpu commands using it must be completed.
+  /// </summary>
+  /// <param name="buffer"></param>
+  void unregister(Buffer& buffer);
+};
+
+/// <summary>
+/// This class is vulkan specialization info wrapper.
+/// Specialization constants are decided at pipeline creation,
+///   so tile sizes or unroll factors are tuned without shader recompiling.
+/// Values are validated with shader module reflection,
+///   and packed into one data block.
+/// </summary>
+class Specialization {
+ private:
+  std::vector<vk::SpecializationMapEntry> m_mapEntries;
+  std::vector<uint8_t> m_data;
+
+ public:
+  Specialization() = default;
+  Specialization(const ShaderModule& shader_module,
+                 const SpecializationValueMap& specialization_values);
+  ~Specialization();
+
+  bool isEmpty() const { return m_mapEntries.empty(); }
+  const auto& getMapEntries() const { return m_mapEntries; }
+  const auto& getData() const { return m_data; }
+
+  /// <summary>
+  /// Get vulkan specialization info.
+  /// Returned info refers this object's memory,
+  ///   so this object must be alive while the info is used.
+  /// </summary>
+  /// <returns></returns>
+  vk::SpecializationInfo getSpecializationInfo() const;
+};
+
 /// <summary>
 /// This class is vulkan pipeline and pipeline layout wrapper.
 /// In Hephics project,
@@ -754,27 +1948,197 @@ class DescriptorSet {
 /// </summary>
 class Pipeline {
  private:
+  friend class ComputePipelineBuilder;
+
   vk::UniquePipeline m_ptrPipeline;
-  vk::UniquePipelineLayout m_ptrPipelineLayout;
+  // owned by hpxc::gpu::Context (shared between the same interfaces)
+  vk::PipelineLayout m_pipelineLayout;
   QueueFamilyType m_queueFamilyType{};
+  vk::PushConstantRange m_pushConstantRange{};
+  std::optional<uint32_t> m_pushDescriptorSetIndex;
+
+  vk::PipelineShaderStageCreateFlags m_shaderStageCreateFlags{};
+  vk::PipelineShaderStageRequiredSubgroupSizeCreateInfo
+      m_requiredSubgroupSizeInfo{};
+
+  vk::ComputePipelineCreateInfo getComputePipelineInfo(
+      const ShaderModule& shader_module,
+      const vk::SpecializationInfo* ptr_specialization_info) const;
 
  public:
   Pipeline(const std::unique_ptr<Context>& ptr_context,
            const DescriptionUnit& description_unit,
            const DescriptorSetLayout& descriptor_set_layout);
+
+  /// <summary>
+  /// Constructor for multiple descriptor sets.
+  /// Each layout is placed at its set index,
+  ///   and missing set indices get an empty layout.
+  /// At most one layout can be push descriptor layout.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  /// <param name="description_unit">whole unit including all sets</param>
+  /// <param name="ptr_descriptor_set_layouts"></param>
+  Pipeline(const std::unique_ptr<Context>& ptr_context,
+           const DescriptionUnit& description_unit,
+           const std::vector<const DescriptorSetLayout*>&
+               ptr_descriptor_set_layouts);
   ~Pipeline();
 
   const auto& getPipeline() const { return m_ptrPipeline; }
-  const auto& getPipelineLayout() const { return m_ptrPipelineLayout; }
+  const auto& getPipelineLayout() const { return m_pipelineLayout; }
   const auto getQueueFamilyType() const { return m_queueFamilyType; }
 
+  /// <summary>
+  /// One of descriptor set layouts of the pipeline is for push descriptors.
+  /// </summary>
+  bool isPushDescriptor() const {
+    return m_pushDescriptorSetIndex.has_value();
+  }
+  const auto& getPushDescriptorSetIndex() const {
+    return m_pushDescriptorSetIndex;
+  }
+
+  /// <summary>
+  /// Union of all push constant ranges of the pipeline layout
+  ///   (size 0: no push constants).
+  /// </summary>
+  const auto& getPushConstantRange() const { return m_pushConstantRange; }
+
+  /// <summary>
+  /// Require subgroup size of the compute pipeline constructed after this.
+  /// VK_EXT_subgroup_size_control is required.
+  /// If the size is not supported, std::runtime_error is thrown.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  /// <param name="subgroup_size">
+  ///   power of two in [min_size, max_size] of hpxc::SubgroupProperties
+  ///   (0: driver's choice)
+  /// </param>
+  /// <param name="require_full_subgroups">
+  ///   all subgroups in a workgroup are fully populated
+  ///   (local_size_x must be a multiple of subgroup_size)
+  /// </param>
+  void setRequiredSubgroupSize(const std::unique_ptr<Context>& ptr_context,
+                               const uint32_t subgroup_size,
+                               const bool require_full_subgroups = false);
+
   /// <summary>
   /// Construt pipeline for compute shader.
   /// </summary>
   /// <param name="ptr_context"></param>
   /// <param name="shader_module"></param>
-  void constructComputePipeline(const std::unique_ptr<Context>& ptr_context,
-                                const ShaderModule& shader_module);
+  /// <param name="specialization_values">
+  ///   specialization constant values (empty: shader default values)
+  /// </param>
+  void constructComputePipeline(
+      const std::unique_ptr<Context>& ptr_context,
+      const ShaderModule& shader_module,
+      const SpecializationValueMap& specialization_values = {});
+};
+
+/// <summary>
+/// This class batches compute pipeline creation.
+/// Added pipelines are created by one vkCreateComputePipelines call
+///   (build), or by several calls on background threads (buildAsync).
+/// Pipeline and shader module objects must be alive until building is done.
+/// </summary>
+class ComputePipelineBuilder {
+ private:
+  struct Entry {
+    Pipeline* ptr_pipeline = nullptr;
+    const ShaderModule* ptr_shader_module = nullptr;
+    Specialization specialization;
+  };
+
+  std::vector<Entry> m_entries;
+
+  static void createPipelines(const std::unique_ptr<Context>& ptr_context,
+                              const std::vector<Entry>& entries,
+                              const size_t begin_idx, const size_t end_idx);
+
+ public:
+  ComputePipelineBuilder() = default;
+  ~ComputePipelineBuilder();
+
+  /// <summary>
+  /// Register pipeline creation.
+  /// The pipeline must have been constructed (pipeline layout is ready).
+  /// </summary>
+  /// <param name="pipeline">output pipeline</param>
+  /// <param name="shader_module"></param>
+  /// <param name="specialization_values"></param>
+  void add(Pipeline& pipeline, const ShaderModule& shader_module,
+           const SpecializationValueMap& specialization_values = {});
+
+  size_t getCount() const { return m_entries.size(); }
+
+  /// <summary>
+  /// Create all registered pipelines with one vkCreateComputePipelines call.
+  /// Registered entries are cleared.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  void build(const std::unique_ptr<Context>& ptr_context);
+
+  /// <summary>
+  /// Create all registered pipelines on background threads.
+  /// Entries are devided into chunks, and each chunk is created
+  ///   by one vkCreateComputePipelines call on its own thread.
+  /// Registered entries are cleared.
+  /// </summary>
+  /// <param name="ptr_context">
+  ///   must be alive until all futures are ready
+  /// </param>
+  /// <param name="thread_count">0: hardware concurrency</param>
+  /// <returns>
+  ///   one future for each added pipeline (in added order).
+  ///   Each pipeline must not be used until its future is ready.
+  /// </returns>
+  std::vector<std::shared_future<void>> buildAsync(
+      const std::unique_ptr<Context>& ptr_context,
+      const uint32_t thread_count = 0U);
+};
+
+/// <summary>
+/// This class caches pipeline variants
+///   keyed by (shader code, pipeline layout, specialization constant values).
+/// Each variant is created only at the first request,
+///   so switching variants at runtime is cheap.
+/// This class is thread-safe.
+/// </summary>
+class PipelineVariantCache {
+ private:
+  std::shared_mutex m_mutex;
+  std::unordered_map<std::string, std::unique_ptr<Pipeline>> m_pipelineMap;
+
+ public:
+  PipelineVariantCache() = default;
+  ~PipelineVariantCache();
+
+  /// <summary>
+  /// Get compute pipeline variant.
+  /// If the variant is not cached, it is constructed.
+  /// </summary>
+  /// <param name="ptr_context"></param>
+  /// <param name="description_unit"></param>
+  /// <param name="descriptor_set_layout"></param>
+  /// <param name="shader_module"></param>
+  /// <param name="specialization_values"></param>
+  /// <returns>pipeline alive until this cache is cleared</returns>
+  const Pipeline& getComputePipeline(
+      const std::unique_ptr<Context>& ptr_context,
+      const DescriptionUnit& description_unit,
+      const DescriptorSetLayout& descriptor_set_layout,
+      const ShaderModule& shader_module,
+      const SpecializationValueMap& specialization_values);
+
+  size_t getVariantCount();
+
+  /// <summary>
+  /// Destroy all cached pipelines.
+  /// Gpu must not use them any longer.
+  /// </summary>
+  void clear();
 };
 
 /// <summary>
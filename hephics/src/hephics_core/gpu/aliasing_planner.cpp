@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <numeric>
+
+#include "../gpu.hpp"
+#include "vk_helper.hpp"
+
+static bool is_overlapped(const uint32_t first_pass_a,
+                          const uint32_t last_pass_a,
+                          const uint32_t first_pass_b,
+                          const uint32_t last_pass_b) {
+  return first_pass_a <= last_pass_b && first_pass_b <= last_pass_a;
+}
+
+static uint32_t find_memory_type_index(
+    const std::unique_ptr<hpxc::gpu::Context>& ptr_context,
+    const uint32_t memory_type_bits) {
+  const vk::MemoryPropertyFlags vk_memory_usage =
+      vk_helper::getMemoryPropertyFlags(hpxc::MemoryUsage::GpuOnly);
+  const auto memory_props =
+      ptr_context->getDevice()->getPhysicalDevice().getMemoryProperties();
+
+  for (uint32_t memory_type_idx = 0U;
+       memory_type_idx < memory_props.memoryTypeCount; memory_type_idx += 1U) {
+    if ((memory_type_bits & (1U << memory_type_idx)) &&
+        (memory_props.memoryTypes.at(memory_type_idx).propertyFlags &
+         vk_memory_usage) == vk_memory_usage) {
+      return memory_type_idx;
+    }
+  }
+
+  throw std::runtime_error("no memory type for aliased images.");
+}
+
+hpxc::gpu::AliasingPlanner::~AliasingPlanner() {}
+
+size_t hpxc::gpu::AliasingPlanner::addImage(
+    const std::unique_ptr<Context>& ptr_context,
+    const TransferType transfer_type,
+    const std::vector<ImageUsage>& image_usages,
+    const ImageSubInfo& image_sub_info, const uint32_t first_pass,
+    const uint32_t last_pass) {
+  if (m_isBuilt) {
+    throw std::runtime_error("image cannot be added after build.");
+  }
+  if (first_pass > last_pass) {
+    throw std::runtime_error("first pass must not be after last pass.");
+  }
+
+  Resource resource;
+  resource.ptr_image = std::make_unique<Image>(ptr_context, transfer_type,
+                                               image_usages, image_sub_info);
+  resource.first_pass = first_pass;
+  resource.last_pass = last_pass;
+  resource.memory_requirements =
+      resource.ptr_image->getMemoryRequirements(ptr_context);
+
+  m_resources.push_back(std::move(resource));
+
+  return m_resources.size() - 1U;
+}
+
+void hpxc::gpu::AliasingPlanner::build(
+    const std::unique_ptr<Context>& ptr_context) {
+  if (m_isBuilt) {
+    throw std::runtime_error("aliasing planner is already built.");
+  }
+
+  // larger images first, so that smaller ones fill the blocks
+  std::vector<size_t> resource_order(m_resources.size());
+  std::iota(resource_order.begin(), resource_order.end(), 0U);
+  std::stable_sort(resource_order.begin(), resource_order.end(),
+                   [&](const size_t lhs, const size_t rhs) {
+                     return m_resources.at(lhs).memory_requirements.size >
+                            m_resources.at(rhs).memory_requirements.size;
+                   });
+
+  for (const auto resource_index : resource_order) {
+    auto& resource = m_resources.at(resource_index);
+    const auto& requirements = resource.memory_requirements;
+
+    const auto iter = std::find_if(
+        m_memoryBlocks.begin(), m_memoryBlocks.end(),
+        [&](const MemoryBlock& memory_block) {
+          if ((memory_block.memory_type_bits &
+               requirements.memoryTypeBits) == 0U) {
+            return false;
+          }
+
+          return std::none_of(
+              memory_block.resource_indices.begin(),
+              memory_block.resource_indices.end(), [&](const size_t idx) {
+                const auto& placed = m_resources.at(idx);
+                return is_overlapped(resource.first_pass, resource.last_pass,
+                                     placed.first_pass, placed.last_pass);
+              });
+        });
+
+    // index is taken before push_back, which invalidates the iterator
+    const auto block_index =
+        static_cast<uint32_t>(iter - m_memoryBlocks.begin());
+    if (block_index == m_memoryBlocks.size()) {
+      MemoryBlock memory_block;
+      memory_block.memory_type_bits = requirements.memoryTypeBits;
+      m_memoryBlocks.push_back(std::move(memory_block));
+    }
+    auto& memory_block = m_memoryBlocks.at(block_index);
+
+    // every image is placed at offset 0, which satisfies any alignment
+    memory_block.size = std::max(memory_block.size, requirements.size);
+    memory_block.memory_type_bits &= requirements.memoryTypeBits;
+    memory_block.resource_indices.push_back(resource_index);
+    resource.block_index = block_index;
+  }
+
+  for (auto& memory_block : m_memoryBlocks) {
+    vk::MemoryAllocateInfo allocation_info{};
+    allocation_info.setMemoryTypeIndex(
+        find_memory_type_index(ptr_context, memory_block.memory_type_bits));
+    allocation_info.setAllocationSize(memory_block.size);
+
+    memory_block.ptr_memory =
+        ptr_context->getDevice()->getLogicalDevice()->allocateMemoryUnique(
+            allocation_info);
+  }
+
+  for (auto& resource : m_resources) {
+    const auto& image = *resource.ptr_image;
+    image.bindMemory(ptr_context,
+                     m_memoryBlocks.at(resource.block_index).ptr_memory.get(),
+                     0U);
+
+    ImageViewInfo image_view_info{};
+    image_view_info.aspect = ImageAspect::Color;
+    image_view_info.base_mip_level = 0U;
+    image_view_info.mip_levels = image.getMipLevels();
+    image_view_info.base_array_layer = 0U;
+    image_view_info.array_layers = image.getArrayLayers();
+    image_view_info.is_array = image.getArrayLayers() > 1U;
+    resource.ptr_image_view =
+        std::make_unique<ImageView>(ptr_context, image, image_view_info);
+
+    // contents of the previous image in the block are discarded,
+    //   and its writes must be finished before this image is written
+    vk::ImageMemoryBarrier barrier;
+    barrier.setImage(image.getImage());
+    barrier.setOldLayout(vk::ImageLayout::eUndefined);
+    barrier.setNewLayout(vk::ImageLayout::eGeneral);
+    barrier.setSrcAccessMask(vk::AccessFlagBits::eShaderWrite |
+                             vk::AccessFlagBits::eTransferWrite);
+    barrier.setDstAccessMask(vk::AccessFlagBits::eShaderRead |
+                             vk::AccessFlagBits::eShaderWrite);
+    barrier.setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED);
+    barrier.setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED);
+    barrier.setSubresourceRange(vk::ImageSubresourceRange(
+        vk::ImageAspectFlagBits::eColor, 0U, image.getMipLevels(), 0U,
+        image.getArrayLayers()));
+
+    m_passBarrierMap[resource.first_pass].push_back(barrier);
+  }
+
+  m_isBuilt = true;
+}
+
+std::span<const vk::ImageMemoryBarrier>
+hpxc::gpu::AliasingPlanner::getAliasingBarriers(
+    const uint32_t pass_index) const {
+  const auto iter = m_passBarrierMap.find(pass_index);
+  if (iter == m_passBarrierMap.end()) {
+    return {};
+  }
+
+  return iter->second;
+}
+
+vk::DeviceSize hpxc::gpu::AliasingPlanner::getAllocatedSize() const {
+  vk::DeviceSize allocated_size = 0U;
+  for (const auto& memory_block : m_memoryBlocks) {
+    allocated_size += memory_block.size;
+  }
+
+  return allocated_size;
+}
+
+vk::DeviceSize hpxc::gpu::AliasingPlanner::getUnaliasedSize() const {
+  vk::DeviceSize unaliased_size = 0U;
+  for (const auto& resource : m_resources) {
+    unaliased_size += resource.memory_requirements.size;
+  }
+
+  return unaliased_size;
+}
@@ -0,0 +1,212 @@
+#include <algorithm>
+#include <format>
+
+#include "../gpu.hpp"
+#include "vk_helper.hpp"
+
+static void check_bindless_capacity(const std::string& name,
+                                    const uint32_t capacity,
+                                    const uint32_t max_per_set,
+                                    const uint32_t max_per_stage) {
+  // all stages can access the arrays, so per stage limit applies too
+  const auto limit = std::min(max_per_set, max_per_stage);
+  if (capacity > limit) {
+    throw std::runtime_error(std::format(
+        "bindless {} capacity {} exceeds the device limit {}.", name,
+        capacity, limit));
+  }
+}
+
+uint32_t hpxc::gpu::BindlessTable::IndexAllocator::allocate() {
+  if (!free_indices.empty()) {
+    const auto index = free_indices.back();
+    free_indices.pop_back();
+
+    return index;
+  }
+
+  if (next_index >= capacity) {
+    throw std::runtime_error(
+        std::format("bindless table is full (capacity: {}).", capacity));
+  }
+
+  return next_index++;
+}
+
+void hpxc::gpu::BindlessTable::IndexAllocator::release(const uint32_t index) {
+  if (index != INVALID_BINDLESS_INDEX) {
+    free_indices.push_back(index);
+  }
+}
+
+hpxc::gpu::BindlessTable::BindlessTable(
+    const std::unique_ptr<Context>& ptr_context,
+    const uint32_t sampled_image_capacity,
+    const uint32_t storage_image_capacity,
+    const uint32_t storage_buffer_capacity) {
+  if (!ptr_context->getDevice()->isBindlessSupported()) {
+    throw std::runtime_error("descriptor indexing is not supported.");
+  }
+
+  {
+    const auto properties =
+        ptr_context->getDevice()
+            ->getPhysicalDevice()
+            .getProperties2<vk::PhysicalDeviceProperties2,
+                            vk::PhysicalDeviceDescriptorIndexingProperties>();
+    const auto& limits =
+        properties.get<vk::PhysicalDeviceDescriptorIndexingProperties>();
+
+    // combined image sampler counts as both a sampler and a sampled image
+    check_bindless_capacity(
+        "sampled image", sampled_image_capacity,
+        std::min(limits.maxDescriptorSetUpdateAfterBindSampledImages,
+                 limits.maxDescriptorSetUpdateAfterBindSamplers),
+        std::min(limits.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                 limits.maxPerStageDescriptorUpdateAfterBindSamplers));
+    check_bindless_capacity(
+        "storage image", storage_image_capacity,
+        limits.maxDescriptorSetUpdateAfterBindStorageImages,
+        limits.maxPerStageDescriptorUpdateAfterBindStorageImages);
+    check_bindless_capacity(
+        "storage buffer", storage_buffer_capacity,
+        limits.maxDescriptorSetUpdateAfterBindStorageBuffers,
+        limits.maxPerStageDescriptorUpdateAfterBindStorageBuffers);
+
+    const auto resource_count = static_cast<uint64_t>(sampled_image_capacity) +
+                                storage_image_capacity +
+                                storage_buffer_capacity;
+    if (resource_count > limits.maxPerStageUpdateAfterBindResources) {
+      throw std::runtime_error(std::format(
+          "bindless capacities {} exceed the device limit {}.",
+          resource_count, limits.maxPerStageUpdateAfterBindResources));
+    }
+  }
+
+  m_sampledImageIndices.capacity = sampled_image_capacity;
+  m_storageImageIndices.capacity = storage_image_capacity;
+  m_storageBufferIndices.capacity = storage_buffer_capacity;
+
+  const std::vector<vk::DescriptorSetLayoutBinding> bindings = {
+      {SAMPLED_IMAGE_BINDING, vk::DescriptorType::eCombinedImageSampler,
+       sampled_image_capacity, vk::ShaderStageFlagBits::eAll},
+      {STORAGE_IMAGE_BINDING, vk::DescriptorType::eStorageImage,
+       storage_image_capacity, vk::ShaderStageFlagBits::eAll},
+      {STORAGE_BUFFER_BINDING, vk::DescriptorType::eStorageBuffer,
+       storage_buffer_capacity, vk::ShaderStageFlagBits::eAll},
+  };
+
+  const vk::DescriptorBindingFlags binding_flags =
+      vk::DescriptorBindingFlagBits::ePartiallyBound |
+      vk::DescriptorBindingFlagBits::eUpdateAfterBind |
+      vk::DescriptorBindingFlagBits::eUpdateUnusedWhilePending;
+
+  m_ptrDescriptorSetLayout = std::make_unique<DescriptorSetLayout>(
+      ptr_context, bindings,
+      std::vector<vk::DescriptorBindingFlags>(bindings.size(), binding_flags),
+      vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool);
+
+  m_ptrDescriptorSet =
+      std::make_unique<DescriptorSet>(ptr_context, *m_ptrDescriptorSetLayout);
+}
+
+hpxc::gpu::BindlessTable::~BindlessTable() {}
+
+uint32_t hpxc::gpu::BindlessTable::registerSampledImage(
+    const std::unique_ptr<Context>& ptr_context, Image& image,
+    const ImageView& image_view, const Sampler& sampler,
+    const ImageLayout image_layout) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (image.m_bindlessSampledIndex == INVALID_BINDLESS_INDEX) {
+    image.m_bindlessSampledIndex = m_sampledImageIndices.allocate();
+  }
+
+  vk::DescriptorImageInfo image_info;
+  image_info.setSampler(sampler.getSampler().get());
+  image_info.setImageView(image_view.getImageView().get());
+  image_info.setImageLayout(vk_helper::getImageLayout(image_layout));
+
+  vk::WriteDescriptorSet write_descriptor_set;
+  write_descriptor_set.setDstSet(m_ptrDescriptorSet->getDescriptorSet());
+  write_descriptor_set.setDstBinding(SAMPLED_IMAGE_BINDING);
+  write_descriptor_set.setDstArrayElement(image.m_bindlessSampledIndex);
+  write_descriptor_set.setDescriptorType(
+      vk::DescriptorType::eCombinedImageSampler);
+  write_descriptor_set.setImageInfo(image_info);
+
+  ptr_context->getDevice()->getLogicalDevice()->updateDescriptorSets(
+      write_descriptor_set, nullptr);
+
+  return image.m_bindlessSampledIndex;
+}
+
+uint32_t hpxc::gpu::BindlessTable::registerStorageImage(
+    const std::unique_ptr<Context>& ptr_context, Image& image,
+    const ImageView& image_view) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (image.m_bindlessStorageIndex == INVALID_BINDLESS_INDEX) {
+    image.m_bindlessStorageIndex = m_storageImageIndices.allocate();
+  }
+
+  vk::DescriptorImageInfo image_info;
+  image_info.setImageView(image_view.getImageView().get());
+  image_info.setImageLayout(vk::ImageLayout::eGeneral);
+
+  vk::WriteDescriptorSet write_descriptor_set;
+  write_descriptor_set.setDstSet(m_ptrDescriptorSet->getDescriptorSet());
+  write_descriptor_set.setDstBinding(STORAGE_IMAGE_BINDING);
+  write_descriptor_set.setDstArrayElement(image.m_bindlessStorageIndex);
+  write_descriptor_set.setDescriptorType(vk::DescriptorType::eStorageImage);
+  write_descriptor_set.setImageInfo(image_info);
+
+  ptr_context->getDevice()->getLogicalDevice()->updateDescriptorSets(
+      write_descriptor_set, nullptr);
+
+  return image.m_bindlessStorageIndex;
+}
+
+uint32_t hpxc::gpu::BindlessTable::registerStorageBuffer(
+    const std::unique_ptr<Context>& ptr_context, Buffer& buffer) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (buffer.m_bindlessIndex == INVALID_BINDLESS_INDEX) {
+    buffer.m_bindlessIndex = m_storageBufferIndices.allocate();
+  }
+
+  vk::DescriptorBufferInfo buffer_info;
+  buffer_info.setBuffer(buffer.getBuffer());
+  buffer_info.setOffset(0U);
+  buffer_info.setRange(VK_WHOLE_SIZE);
+
+  vk::WriteDescriptorSet write_descriptor_set;
+  write_descriptor_set.setDstSet(m_ptrDescriptorSet->getDescriptorSet());
+  write_descriptor_set.setDstBinding(STORAGE_BUFFER_BINDING);
+  write_descriptor_set.setDstArrayElement(buffer.m_bindlessIndex);
+  write_descriptor_set.setDescriptorType(vk::DescriptorType::eStorageBuffer);
+  write_descriptor_set.setBufferInfo(buffer_info);
+
+  ptr_context->getDevice()->getLogicalDevice()->updateDescriptorSets(
+      write_descriptor_set, nullptr);
+
+  return buffer.m_bindlessIndex;
+}
+
+void hpxc::gpu::BindlessTable::unregister(Image& image) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  m_sampledImageIndices.release(image.m_bindlessSampledIndex);
+  m_storageImageIndices.release(image.m_bindlessStorageIndex);
+
+  image.m_bindlessSampledIndex = INVALID_BINDLESS_INDEX;
+  image.m_bindlessStorageIndex = INVALID_BINDLESS_INDEX;
+}
+
+void hpxc::gpu::BindlessTable::unregister(Buffer& buffer) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  m_storageBufferIndices.release(buffer.m_bindlessIndex);
+
+  buffer.m_bindlessIndex = INVALID_BINDLESS_INDEX;
+}
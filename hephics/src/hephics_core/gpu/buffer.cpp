@@ -113,3 +113,19 @@ void hpxc::gpu::Buffer::unmapMemory(
     const std::unique_ptr<Context>& ptr_context) const {
   ptr_context->getDevice()->getLogicalDevice()->unmapMemory(m_ptrMemory.get());
 }
+
+void hpxc::gpu::Buffer::flushMemory(
+    const std::unique_ptr<Context>& ptr_context) const {
+  const vk::MappedMemoryRange memory_range(m_ptrMemory.get(), 0U,
+                                           VK_WHOLE_SIZE);
+  ptr_context->getDevice()->getLogicalDevice()->flushMappedMemoryRanges(
+      memory_range);
+}
+
+void hpxc::gpu::Buffer::invalidateMemory(
+    const std::unique_ptr<Context>& ptr_context) const {
+  const vk::MappedMemoryRange memory_range(m_ptrMemory.get(), 0U,
+                                           VK_WHOLE_SIZE);
+  ptr_context->getDevice()->getLogicalDevice()->invalidateMappedMemoryRanges(
+      memory_range);
+}
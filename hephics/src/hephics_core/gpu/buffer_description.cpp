@@ -2,18 +2,27 @@
 
 #include "../gpu.hpp"
 
+static bool is_dynamic_buffer(const vk::DescriptorType descriptor_type) {
+  return descriptor_type == vk::DescriptorType::eUniformBufferDynamic ||
+         descriptor_type == vk::DescriptorType::eStorageBufferDynamic;
+}
+
 hpxc::gpu::BufferDescription::BufferDescription(
-    const DescriptorInfo& descriptor_info, const Buffer& buffer) {
-  m_ptrBufferInfo = std::make_shared<vk::DescriptorBufferInfo>();
-  m_ptrBufferInfo->setBuffer(buffer.getBuffer());
-  m_ptrBufferInfo->setOffset(0);
-  m_ptrBufferInfo->setRange(buffer.getSize());
+    const DescriptorInfo& descriptor_info, const Buffer& buffer,
+    const uint32_t array_element)
+    : m_binding(descriptor_info.binding),
+      m_arrayElement(array_element),
+      m_descriptorType(descriptor_info.type) {
+  if (descriptor_info.count != 0U && array_element >= descriptor_info.count) {
+    throw std::runtime_error("array element is out of descriptor array.");
+  }
 
-  m_ptrWriteDescriptorSet = std::make_shared<vk::WriteDescriptorSet>();
-  m_ptrWriteDescriptorSet->setDstBinding(descriptor_info.binding);
-  m_ptrWriteDescriptorSet->setDstArrayElement(0);
-  m_ptrWriteDescriptorSet->setDescriptorType(descriptor_info.type);
-  m_ptrWriteDescriptorSet->setBufferInfo(*m_ptrBufferInfo);
+  m_bufferInfo.setBuffer(buffer.getBuffer());
+  m_bufferInfo.setOffset(0);
+  // dynamic buffer is bound with its block size, offset is given at dispatch
+  m_bufferInfo.setRange(is_dynamic_buffer(descriptor_info.type)
+                            ? descriptor_info.size
+                            : buffer.getSize());
 }
 
 hpxc::gpu::BufferDescription::~BufferDescription() {}
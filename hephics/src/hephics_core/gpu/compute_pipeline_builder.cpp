@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <thread>
+
+#include "../gpu.hpp"
+
+hpxc::gpu::ComputePipelineBuilder::~ComputePipelineBuilder() {}
+
+void hpxc::gpu::ComputePipelineBuilder::createPipelines(
+    const std::unique_ptr<Context>& ptr_context,
+    const std::vector<Entry>& entries, const size_t begin_idx,
+    const size_t end_idx) {
+  // specialization infos are kept here while create infos refer them
+  std::vector<vk::SpecializationInfo> specialization_infos;
+  specialization_infos.reserve(end_idx - begin_idx);
+
+  std::vector<vk::ComputePipelineCreateInfo> compute_pipeline_infos;
+  compute_pipeline_infos.reserve(end_idx - begin_idx);
+
+  for (size_t idx = begin_idx; idx < end_idx; idx += 1U) {
+    const auto& entry = entries.at(idx);
+
+    specialization_infos.push_back(
+        entry.specialization.getSpecializationInfo());
+
+    const auto ptr_specialization_info = entry.specialization.isEmpty()
+                                             ? nullptr
+                                             : &specialization_infos.back();
+
+    compute_pipeline_infos.push_back(entry.ptr_pipeline->getComputePipelineInfo(
+        *entry.ptr_shader_module, ptr_specialization_info));
+  }
+
+  auto pipelines = ptr_context->getDevice()
+                       ->getLogicalDevice()
+                       ->createComputePipelinesUnique(nullptr,
+                                                      compute_pipeline_infos)
+                       .value;
+
+  for (size_t idx = begin_idx; idx < end_idx; idx += 1U) {
+    auto& pipeline = *entries.at(idx).ptr_pipeline;
+
+    pipeline.m_ptrPipeline = std::move(pipelines.at(idx - begin_idx));
+    pipeline.m_queueFamilyType = QueueFamilyType::Compute;
+  }
+}
+
+void hpxc::gpu::ComputePipelineBuilder::add(
+    Pipeline& pipeline, const ShaderModule& shader_module,
+    const SpecializationValueMap& specialization_values) {
+  m_entries.push_back(
+      Entry{&pipeline, &shader_module,
+            Specialization(shader_module, specialization_values)});
+}
+
+void hpxc::gpu::ComputePipelineBuilder::build(
+    const std::unique_ptr<Context>& ptr_context) {
+  if (!m_entries.empty()) {
+    createPipelines(ptr_context, m_entries, 0U, m_entries.size());
+  }
+
+  m_entries.clear();
+}
+
+std::vector<std::shared_future<void>>
+hpxc::gpu::ComputePipelineBuilder::buildAsync(
+    const std::unique_ptr<Context>& ptr_context, const uint32_t thread_count) {
+  std::vector<std::shared_future<void>> results;
+  if (m_entries.empty()) {
+    return results;
+  }
+
+  const auto chunk_count = std::min<size_t>(
+      m_entries.size(),
+      std::max(1U, thread_count != 0U ? thread_count
+                                      : std::thread::hardware_concurrency()));
+  const auto chunk_size = (m_entries.size() + chunk_count - 1U) / chunk_count;
+
+  // entries are moved, so this builder can be reused immediately
+  const auto ptr_entries =
+      std::make_shared<const std::vector<Entry>>(std::move(m_entries));
+  m_entries.clear();
+
+  results.reserve(ptr_entries->size());
+  for (size_t begin_idx = 0U; begin_idx < ptr_entries->size();
+       begin_idx += chunk_size) {
+    const auto end_idx = std::min(begin_idx + chunk_size, ptr_entries->size());
+
+    // ptr_context is referred (not copied) because it is unique
+    const std::shared_future<void> chunk_future =
+        std::async(std::launch::async,
+                   [&ptr_context, ptr_entries, begin_idx, end_idx]() {
+                     createPipelines(ptr_context, *ptr_entries, begin_idx,
+                                     end_idx);
+                   })
+            .share();
+
+    for (size_t idx = begin_idx; idx < end_idx; idx += 1U) {
+      results.push_back(chunk_future);
+    }
+  }
+
+  return results;
+}
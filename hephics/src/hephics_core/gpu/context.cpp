@@ -1,5 +1,12 @@
+#include <algorithm>
+
 #include "../gpu.hpp"
 
+template <typename T>
+static void append_signature(std::string& signature, const T& value) {
+  signature.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
 hpxc::gpu::Context::Context(
     std::shared_ptr<gpu_ui_connection::WindowSurface> ptr_window_surface) {
   // Initialize Vulkan.hpp
@@ -59,9 +66,125 @@ hpxc::gpu::Context::Context(
 }
 
 hpxc::gpu::Context::~Context() {
+  // cached layouts must be destroyed before the device
+  m_pipelineLayoutCache.clear();
+  m_descriptorSetLayoutCache.clear();
+
   m_ptrDevice.release();
   m_ptrInstance.release();
 #ifdef HEPHICS_DEBUG
   m_ptrMessenger.release();
 #endif
 }
+
+vk::DescriptorSetLayout hpxc::gpu::Context::getDescriptorSetLayout(
+    const std::vector<vk::DescriptorSetLayoutBinding>& bindings,
+    const vk::DescriptorSetLayoutCreateFlags flags,
+    const std::vector<vk::DescriptorBindingFlags>& binding_flags) {
+  if (!binding_flags.empty() && binding_flags.size() != bindings.size()) {
+    throw std::runtime_error("binding flags count must match bindings.");
+  }
+
+  // binding order does not change the layout
+  std::vector<size_t> order(bindings.size());
+  for (size_t idx = 0U; idx < order.size(); idx += 1U) {
+    order.at(idx) = idx;
+  }
+  std::sort(order.begin(), order.end(), [&](const auto lhs, const auto rhs) {
+    return bindings.at(lhs).binding < bindings.at(rhs).binding;
+  });
+
+  std::vector<vk::DescriptorSetLayoutBinding> sorted_bindings;
+  std::vector<vk::DescriptorBindingFlags> sorted_binding_flags;
+  for (const auto idx : order) {
+    sorted_bindings.push_back(bindings.at(idx));
+    if (!binding_flags.empty()) {
+      sorted_binding_flags.push_back(binding_flags.at(idx));
+    }
+  }
+
+  std::string signature;
+  append_signature(signature, static_cast<VkFlags>(flags));
+  for (size_t idx = 0U; idx < sorted_bindings.size(); idx += 1U) {
+    const auto& binding = sorted_bindings.at(idx);
+    append_signature(signature, binding.binding);
+    append_signature(signature, binding.descriptorType);
+    append_signature(signature, binding.descriptorCount);
+    append_signature(signature, static_cast<VkFlags>(binding.stageFlags));
+    append_signature(signature,
+                     sorted_binding_flags.empty()
+                         ? VkFlags{0U}
+                         : static_cast<VkFlags>(sorted_binding_flags.at(idx)));
+  }
+
+  {
+    std::shared_lock lock(m_layoutCacheMutex);
+    const auto iter = m_descriptorSetLayoutCache.find(signature);
+    if (iter != m_descriptorSetLayoutCache.end()) {
+      return iter->second.get();
+    }
+  }
+
+  vk::DescriptorSetLayoutBindingFlagsCreateInfo binding_flags_info;
+  binding_flags_info.setBindingFlags(sorted_binding_flags);
+
+  vk::DescriptorSetLayoutCreateInfo descriptor_set_layout_info;
+  descriptor_set_layout_info.setFlags(flags);
+  descriptor_set_layout_info.setBindings(sorted_bindings);
+  if (!sorted_binding_flags.empty()) {
+    descriptor_set_layout_info.setPNext(&binding_flags_info);
+  }
+
+  std::unique_lock lock(m_layoutCacheMutex);
+  auto& ptr_layout = m_descriptorSetLayoutCache[signature];
+  if (!ptr_layout) {
+    ptr_layout =
+        m_ptrDevice->getLogicalDevice()->createDescriptorSetLayoutUnique(
+            descriptor_set_layout_info);
+  }
+
+  return ptr_layout.get();
+}
+
+vk::PipelineLayout hpxc::gpu::Context::getPipelineLayout(
+    const std::vector<vk::DescriptorSetLayout>& set_layouts,
+    const std::vector<vk::PushConstantRange>& push_constant_ranges) {
+  // set layouts are deduplicated, so the handles identify them
+  std::string signature;
+  append_signature(signature, set_layouts.size());
+  for (const auto& set_layout : set_layouts) {
+    append_signature(signature, static_cast<VkDescriptorSetLayout>(set_layout));
+  }
+
+  auto sorted_ranges = push_constant_ranges;
+  std::sort(sorted_ranges.begin(), sorted_ranges.end(),
+            [](const auto& lhs, const auto& rhs) {
+              return lhs.offset < rhs.offset;
+            });
+  for (const auto& range : sorted_ranges) {
+    append_signature(signature, static_cast<VkFlags>(range.stageFlags));
+    append_signature(signature, range.offset);
+    append_signature(signature, range.size);
+  }
+
+  {
+    std::shared_lock lock(m_layoutCacheMutex);
+    const auto iter = m_pipelineLayoutCache.find(signature);
+    if (iter != m_pipelineLayoutCache.end()) {
+      return iter->second.get();
+    }
+  }
+
+  vk::PipelineLayoutCreateInfo pipeline_layout_info;
+  pipeline_layout_info.setSetLayouts(set_layouts);
+  pipeline_layout_info.setPushConstantRanges(sorted_ranges);
+
+  std::unique_lock lock(m_layoutCacheMutex);
+  auto& ptr_layout = m_pipelineLayoutCache[signature];
+  if (!ptr_layout) {
+    ptr_layout = m_ptrDevice->getLogicalDevice()->createPipelineLayoutUnique(
+        pipeline_layout_info);
+  }
+
+  return ptr_layout.get();
+}
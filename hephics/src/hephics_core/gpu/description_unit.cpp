@@ -10,6 +10,11 @@ hpxc::gpu::DescriptionUnit::DescriptionUnit(
     for (const auto& [key, descriptor_info] :
          shader_module.getDescriptorInfoMap()) {
       if (m_descriptorInfoMap.contains(key)) {
+        if (m_descriptorInfoMap[key].set != descriptor_info.set ||
+            m_descriptorInfoMap[key].binding != descriptor_info.binding) {
+          throw std::runtime_error(key +
+                                   " is bound differently between shaders.");
+        }
         // merge stage flags because the same descriptor info is used in
         m_descriptorInfoMap[key].stage_flags |= descriptor_info.stage_flags;
         continue;
@@ -30,3 +35,54 @@ hpxc::gpu::DescriptionUnit::DescriptionUnit(
 }
 
 hpxc::gpu::DescriptionUnit::~DescriptionUnit() {}
+
+std::set<uint32_t> hpxc::gpu::DescriptionUnit::getSetIndices() const {
+  std::set<uint32_t> set_indices;
+  for (const auto& [_, descriptor_info] : m_descriptorInfoMap) {
+    set_indices.insert(descriptor_info.set);
+  }
+
+  return set_indices;
+}
+
+hpxc::gpu::DescriptionUnit hpxc::gpu::DescriptionUnit::getSetDescriptionUnit(
+    const uint32_t set_index) const {
+  DescriptionUnit set_description_unit;
+  for (const auto& [key, descriptor_info] : m_descriptorInfoMap) {
+    if (descriptor_info.set == set_index) {
+      set_description_unit.m_descriptorInfoMap[key] = descriptor_info;
+    }
+  }
+
+  return set_description_unit;
+}
+
+void hpxc::gpu::DescriptionUnit::setRuntimeArrayCount(const std::string& name,
+                                                      const uint32_t count) {
+  auto& descriptor_info = m_descriptorInfoMap.at(name);
+  if (!descriptor_info.is_runtime_array) {
+    throw std::runtime_error(name + " is not runtime descriptor array.");
+  }
+  if (count == 0U) {
+    throw std::runtime_error("runtime descriptor array count must be > 0.");
+  }
+
+  descriptor_info.count = count;
+}
+
+void hpxc::gpu::DescriptionUnit::setDynamicBuffer(const std::string& name) {
+  auto& descriptor_info = m_descriptorInfoMap.at(name);
+  switch (descriptor_info.type) {
+    case vk::DescriptorType::eUniformBuffer:
+      descriptor_info.type = vk::DescriptorType::eUniformBufferDynamic;
+      break;
+    case vk::DescriptorType::eStorageBuffer:
+      descriptor_info.type = vk::DescriptorType::eStorageBufferDynamic;
+      break;
+    case vk::DescriptorType::eUniformBufferDynamic:
+    case vk::DescriptorType::eStorageBufferDynamic:
+      break;
+    default:
+      throw std::runtime_error(name + " is not uniform or storage buffer.");
+  }
+}
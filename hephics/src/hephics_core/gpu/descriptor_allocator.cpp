@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <cmath>
+
+#include "../gpu.hpp"
+
+static const std::vector<hpxc::gpu::DescriptorAllocator::PoolSizeRatio>
+    g_default_pool_size_ratios = {
+        {vk::DescriptorType::eStorageBuffer, 4.0f},
+        {vk::DescriptorType::eUniformBuffer, 2.0f},
+        {vk::DescriptorType::eUniformBufferDynamic, 1.0f},
+        {vk::DescriptorType::eStorageBufferDynamic, 1.0f},
+        {vk::DescriptorType::eStorageImage, 2.0f},
+        {vk::DescriptorType::eCombinedImageSampler, 2.0f},
+        {vk::DescriptorType::eSampledImage, 1.0f},
+        {vk::DescriptorType::eSampler, 1.0f},
+};
+
+hpxc::gpu::DescriptorAllocator::DescriptorAllocator(
+    const std::unique_ptr<Context>& ptr_context,
+    const uint32_t initial_sets_per_pool,
+    const std::vector<PoolSizeRatio>& pool_size_ratios,
+    const uint32_t max_sets_per_pool)
+    : m_poolSizeRatios(pool_size_ratios.empty() ? g_default_pool_size_ratios
+                                                : pool_size_ratios),
+      m_setsPerPool(std::max(initial_sets_per_pool, 1U)),
+      m_maxSetsPerPool(std::max(max_sets_per_pool, initial_sets_per_pool)) {
+  m_currentPool = takePool(ptr_context);
+}
+
+hpxc::gpu::DescriptorAllocator::~DescriptorAllocator() {}
+
+vk::DescriptorPool hpxc::gpu::DescriptorAllocator::takePool(
+    const std::unique_ptr<Context>& ptr_context) {
+  // reuse a pool returned by resetPools, if there is
+  if (!m_ptrReadyPools.empty()) {
+    m_ptrUsedPools.push_back(std::move(m_ptrReadyPools.back()));
+    m_ptrReadyPools.pop_back();
+
+    return m_ptrUsedPools.back().get();
+  }
+
+  std::vector<vk::DescriptorPoolSize> pool_sizes;
+  pool_sizes.reserve(m_poolSizeRatios.size());
+  for (const auto& pool_size_ratio : m_poolSizeRatios) {
+    const auto descriptor_count = static_cast<uint32_t>(
+        std::ceil(pool_size_ratio.ratio * static_cast<float_t>(m_setsPerPool)));
+    pool_sizes.emplace_back(pool_size_ratio.type,
+                            std::max(descriptor_count, 1U));
+  }
+
+  vk::DescriptorPoolCreateInfo create_info;
+  create_info.setMaxSets(m_setsPerPool);
+  create_info.setPoolSizes(pool_sizes);
+
+  m_ptrUsedPools.push_back(
+      ptr_context->getDevice()->getLogicalDevice()->createDescriptorPoolUnique(
+          create_info));
+
+  // next pool is larger, so that the pool count stays small
+  m_setsPerPool = std::min(m_setsPerPool * 2U, m_maxSetsPerPool);
+
+  return m_ptrUsedPools.back().get();
+}
+
+vk::DescriptorSet hpxc::gpu::DescriptorAllocator::allocate(
+    const std::unique_ptr<Context>& ptr_context,
+    const DescriptorSetLayout& descriptor_set_layout) {
+  if (descriptor_set_layout.isPushDescriptor()) {
+    throw std::runtime_error(
+        "descriptor set cannot be allocated with push descriptor layout.");
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  vk::DescriptorSetAllocateInfo descriptor_set_allocate_info;
+  descriptor_set_allocate_info.setSetLayouts(
+      descriptor_set_layout.getDescriptorSetLayout());
+
+  // without this, variable count binding is allocated with no descriptor
+  const auto variable_descriptor_count =
+      descriptor_set_layout.getVariableDescriptorCount();
+  vk::DescriptorSetVariableDescriptorCountAllocateInfo variable_count_info;
+  variable_count_info.setDescriptorCounts(variable_descriptor_count);
+  if (variable_descriptor_count != 0U) {
+    descriptor_set_allocate_info.setPNext(&variable_count_info);
+  }
+
+  const auto& ptr_logical_device = ptr_context->getDevice()->getLogicalDevice();
+  try {
+    descriptor_set_allocate_info.setDescriptorPool(m_currentPool);
+
+    return ptr_logical_device->allocateDescriptorSets(
+        descriptor_set_allocate_info)[0];
+  } catch (const vk::OutOfPoolMemoryError&) {
+  } catch (const vk::FragmentedPoolError&) {
+  }
+
+  // current pool is full, retry once with another pool
+  m_currentPool = takePool(ptr_context);
+  descriptor_set_allocate_info.setDescriptorPool(m_currentPool);
+
+  return ptr_logical_device->allocateDescriptorSets(
+      descriptor_set_allocate_info)[0];
+}
+
+void hpxc::gpu::DescriptorAllocator::resetPools(
+    const std::unique_ptr<Context>& ptr_context) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  for (auto& ptr_pool : m_ptrUsedPools) {
+    ptr_context->getDevice()->getLogicalDevice()->resetDescriptorPool(
+        ptr_pool.get());
+    m_ptrReadyPools.push_back(std::move(ptr_pool));
+  }
+  m_ptrUsedPools.clear();
+
+  m_currentPool = takePool(ptr_context);
+}
@@ -4,7 +4,8 @@
 
 hpxc::gpu::DescriptorSet::DescriptorSet(
     const std::unique_ptr<Context>& ptr_context,
-    const DescriptorSetLayout& description_set_layout) {
+    const DescriptorSetLayout& description_set_layout)
+    : m_setIndex(description_set_layout.getSetIndex()) {
   m_ptrDescriptorPool =
       ptr_context->getDevice()->getLogicalDevice()->createDescriptorPoolUnique(
           description_set_layout.getDescriptorPoolInfo());
@@ -13,16 +14,33 @@ hpxc::gpu::DescriptorSet::DescriptorSet(
     vk::DescriptorSetAllocateInfo descriptor_set_allocate_info;
     descriptor_set_allocate_info.setDescriptorPool(m_ptrDescriptorPool.get());
     descriptor_set_allocate_info.setSetLayouts(
-        description_set_layout.getDescriptorSetLayout().get());
+        description_set_layout.getDescriptorSetLayout());
 
-    m_ptrDescriptorSet = std::move(
+    // without this, variable count binding is allocated with no descriptor
+    const auto variable_descriptor_count =
+        description_set_layout.getVariableDescriptorCount();
+    vk::DescriptorSetVariableDescriptorCountAllocateInfo variable_count_info;
+    variable_count_info.setDescriptorCounts(variable_descriptor_count);
+    if (variable_descriptor_count != 0U) {
+      descriptor_set_allocate_info.setPNext(&variable_count_info);
+    }
+
+    m_descriptorSet =
         ptr_context->getDevice()
             ->getLogicalDevice()
-            ->allocateDescriptorSetsUnique(descriptor_set_allocate_info)
-            .front());
+            ->allocateDescriptorSets(descriptor_set_allocate_info)
+            .front();
   }
 }
 
+hpxc::gpu::DescriptorSet::DescriptorSet(
+    const std::unique_ptr<Context>& ptr_context,
+    DescriptorAllocator& descriptor_allocator,
+    const DescriptorSetLayout& description_set_layout)
+    : m_descriptorSet(
+          descriptor_allocator.allocate(ptr_context, description_set_layout)),
+      m_setIndex(description_set_layout.getSetIndex()) {}
+
 hpxc::gpu::DescriptorSet::~DescriptorSet() {}
 
 void hpxc::gpu::DescriptorSet::updateDescriptorSet(
@@ -35,19 +53,40 @@ void hpxc::gpu::DescriptorSet::updateDescriptorSet(
 
   for (const auto& buffer_description : buffer_descriptions) {
     write_descriptor_sets.push_back(buffer_description.getWriteDescriptorSet());
-    write_descriptor_sets.back().setDstSet(m_ptrDescriptorSet.get());
+    write_descriptor_sets.back().setDstSet(m_descriptorSet);
   }
   for (const auto& image_description : image_descriptions) {
     write_descriptor_sets.push_back(image_description.getWriteDescriptorSet());
-    write_descriptor_sets.back().setDstSet(m_ptrDescriptorSet.get());
+    write_descriptor_sets.back().setDstSet(m_descriptorSet);
   }
 
   ptr_context->getDevice()->getLogicalDevice()->updateDescriptorSets(
       write_descriptor_sets, nullptr);
 }
 
+void hpxc::gpu::DescriptorSet::updateDescriptorSet(
+    const std::unique_ptr<Context>& ptr_context,
+    const DescriptorSetLayout& descriptor_set_layout,
+    std::span<const DescriptorUpdateInfo> update_infos) {
+  const auto& ptr_update_template =
+      descriptor_set_layout.getDescriptorUpdateTemplate();
+  if (!ptr_update_template) {
+    throw std::runtime_error("descriptor set layout has no update template.");
+  }
+  if (update_infos.size() < descriptor_set_layout.getUpdateSlotCount()) {
+    throw std::runtime_error("descriptor update infos are not enough.");
+  }
+
+  ptr_context->getDevice()->getLogicalDevice()->updateDescriptorSetWithTemplate(
+      m_descriptorSet, ptr_update_template.get(), update_infos.data());
+}
+
 void hpxc::gpu::DescriptorSet::freeDescriptorSet(
     const std::unique_ptr<Context>& ptr_context) {
+  if (!m_ptrDescriptorPool) {
+    return;
+  }
+
   ptr_context->getDevice()->getLogicalDevice()->freeDescriptorSets(
-      m_ptrDescriptorPool.get(), m_ptrDescriptorSet.get());
+      m_ptrDescriptorPool.get(), m_descriptorSet);
 }
@@ -1,46 +1,184 @@
+#include <algorithm>
+#include <cstddef>
 #include <iostream>
 
 #include "../gpu.hpp"
 
 hpxc::gpu::DescriptorSetLayout::DescriptorSetLayout(
     const std::unique_ptr<Context>& ptr_context,
-    const DescriptionUnit& description_unit) {
+    const DescriptionUnit& description_unit, const bool is_push_descriptor) {
+  if (is_push_descriptor) {
+    if (!ptr_context->getDevice()->isPushDescriptorSupported()) {
+      throw std::runtime_error("push descriptor is not supported.");
+    }
+    m_createFlags = vk::DescriptorSetLayoutCreateFlagBits::ePushDescriptorKHR;
+  }
+
+  const auto set_indices = description_unit.getSetIndices();
+  if (set_indices.size() > 1U) {
+    throw std::runtime_error(
+        "description unit has multiple descriptor sets, "
+        "use DescriptionUnit::getSetDescriptionUnit.");
+  }
+  if (!set_indices.empty()) {
+    m_setIndex = *set_indices.begin();
+  }
+
   std::vector<vk::DescriptorSetLayoutBinding> descriptor_set_layout_bindings;
+  std::vector<vk::DescriptorBindingFlags> descriptor_binding_flags;
+  bool has_runtime_array = false;
 
-  for (const auto& [_key, description] :
+  for (const auto& [key, description] :
        description_unit.getDescriptorInfoMap()) {
+    if (description.count == 0U) {
+      throw std::runtime_error(
+          key + " is runtime descriptor array, its count is not set.");
+    }
+    if (is_push_descriptor &&
+        (description.type == vk::DescriptorType::eUniformBufferDynamic ||
+         description.type == vk::DescriptorType::eStorageBufferDynamic)) {
+      throw std::runtime_error(
+          "dynamic buffer cannot be used with push descriptor.");
+    }
+    if (description.is_runtime_array &&
+        !ptr_context->getDevice()->isBindlessSupported()) {
+      throw std::runtime_error("runtime descriptor array is not supported.");
+    }
+
     {
       vk::DescriptorSetLayoutBinding descriptor_set_layout_binding;
       descriptor_set_layout_binding.setBinding(description.binding);
       descriptor_set_layout_binding.setDescriptorType(description.type);
-      descriptor_set_layout_binding.setDescriptorCount(1U);
+      descriptor_set_layout_binding.setDescriptorCount(description.count);
       descriptor_set_layout_binding.setStageFlags(description.stage_flags);
 
       descriptor_set_layout_bindings.push_back(descriptor_set_layout_binding);
     }
 
+    // application may write fewer descriptors than the count
+    descriptor_binding_flags.push_back(
+        description.is_runtime_array
+            ? vk::DescriptorBindingFlags(
+                  vk::DescriptorBindingFlagBits::ePartiallyBound)
+            : vk::DescriptorBindingFlags{});
+    has_runtime_array |= description.is_runtime_array;
+
     m_descriptorPoolSizes.push_back(
-        vk::DescriptorPoolSize(description.type, 1U));
+        vk::DescriptorPoolSize(description.type, description.count));
   }
 
-  {
-    vk::DescriptorSetLayoutCreateInfo descriptor_set_layout_info;
-    descriptor_set_layout_info.setBindings(descriptor_set_layout_bindings);
+  if (has_runtime_array) {
+    // only the highest binding can have variable count,
+    //   and push descriptor layout cannot have it
+    const auto last_iter = std::max_element(
+        descriptor_set_layout_bindings.begin(),
+        descriptor_set_layout_bindings.end(),
+        [](const auto& lhs, const auto& rhs) {
+          return lhs.binding < rhs.binding;
+        });
+    auto& last_binding_flags = descriptor_binding_flags.at(
+        std::distance(descriptor_set_layout_bindings.begin(), last_iter));
+    if (!is_push_descriptor && last_binding_flags) {
+      last_binding_flags |=
+          vk::DescriptorBindingFlagBits::eVariableDescriptorCount;
+      m_variableDescriptorCount = last_iter->descriptorCount;
+    }
+  } else {
+    descriptor_binding_flags.clear();
+  }
+
+  m_descriptorSetLayout = ptr_context->getDescriptorSetLayout(
+      descriptor_set_layout_bindings, m_createFlags, descriptor_binding_flags);
+
+  if (!is_push_descriptor) {
+    constructDescriptorUpdateTemplate(ptr_context, description_unit);
+  }
+}
 
-    m_ptrDescriptorSetLayout =
-        ptr_context->getDevice()
-            ->getLogicalDevice()
-            ->createDescriptorSetLayoutUnique(descriptor_set_layout_info);
+hpxc::gpu::DescriptorSetLayout::DescriptorSetLayout(
+    const std::unique_ptr<Context>& ptr_context,
+    const std::vector<vk::DescriptorSetLayoutBinding>& bindings,
+    const std::vector<vk::DescriptorBindingFlags>& binding_flags,
+    const vk::DescriptorSetLayoutCreateFlags flags)
+    : m_createFlags(flags) {
+  for (const auto& binding : bindings) {
+    m_descriptorPoolSizes.emplace_back(binding.descriptorType,
+                                       binding.descriptorCount);
   }
+
+  m_descriptorSetLayout =
+      ptr_context->getDescriptorSetLayout(bindings, flags, binding_flags);
 }
 
 hpxc::gpu::DescriptorSetLayout::~DescriptorSetLayout() {}
 
+void hpxc::gpu::DescriptorSetLayout::constructDescriptorUpdateTemplate(
+    const std::unique_ptr<Context>& ptr_context,
+    const DescriptionUnit& description_unit) {
+  std::vector<std::pair<std::string, DescriptorInfo>> descriptor_infos(
+      description_unit.getDescriptorInfoMap().begin(),
+      description_unit.getDescriptorInfoMap().end());
+  std::sort(descriptor_infos.begin(), descriptor_infos.end(),
+            [](const auto& lhs, const auto& rhs) {
+              return lhs.second.binding < rhs.second.binding;
+            });
+
+  std::vector<vk::DescriptorUpdateTemplateEntry> entries;
+  entries.reserve(descriptor_infos.size());
+  for (const auto& [name, descriptor_info] : descriptor_infos) {
+    // array elements use consecutive slots
+    const auto slot = m_updateSlotCount;
+    const auto is_buffer =
+        descriptor_info.type == vk::DescriptorType::eUniformBuffer ||
+        descriptor_info.type == vk::DescriptorType::eStorageBuffer ||
+        descriptor_info.type == vk::DescriptorType::eUniformBufferDynamic ||
+        descriptor_info.type == vk::DescriptorType::eStorageBufferDynamic;
+    const auto member_offset =
+        is_buffer ? offsetof(DescriptorUpdateInfo, buffer_info)
+                  : offsetof(DescriptorUpdateInfo, image_info);
+
+    vk::DescriptorUpdateTemplateEntry entry;
+    entry.setDstBinding(descriptor_info.binding);
+    entry.setDstArrayElement(0U);
+    entry.setDescriptorCount(descriptor_info.count);
+    entry.setDescriptorType(descriptor_info.type);
+    entry.setOffset(slot * sizeof(DescriptorUpdateInfo) + member_offset);
+    entry.setStride(sizeof(DescriptorUpdateInfo));
+    entries.push_back(entry);
+
+    m_updateSlotMap.insert({name, slot});
+    m_updateSlotCount += descriptor_info.count;
+  }
+
+  if (entries.empty()) {
+    return;
+  }
+
+  vk::DescriptorUpdateTemplateCreateInfo create_info;
+  create_info.setDescriptorUpdateEntries(entries);
+  create_info.setTemplateType(vk::DescriptorUpdateTemplateType::eDescriptorSet);
+  create_info.setDescriptorSetLayout(m_descriptorSetLayout);
+
+  m_ptrDescriptorUpdateTemplate =
+      ptr_context->getDevice()
+          ->getLogicalDevice()
+          ->createDescriptorUpdateTemplateUnique(create_info);
+}
+
 vk::DescriptorPoolCreateInfo
 hpxc::gpu::DescriptorSetLayout::getDescriptorPoolInfo() const {
+  if (isPushDescriptor()) {
+    throw std::runtime_error(
+        "descriptor set cannot be allocated with push descriptor layout.");
+  }
+
   vk::DescriptorPoolCreateInfo create_info;
   create_info.setMaxSets(1U);
   create_info.setFlags(vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet);
+  if (m_createFlags &
+      vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool) {
+    create_info.flags |= vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind;
+  }
   create_info.setPoolSizes(m_descriptorPoolSizes);
 
   return create_info;
@@ -0,0 +1,185 @@
+#include "../gpu.hpp"
+#include "vk_helper.hpp"
+
+static bool is_dynamic_buffer(const vk::DescriptorType descriptor_type) {
+  return descriptor_type == vk::DescriptorType::eUniformBufferDynamic ||
+         descriptor_type == vk::DescriptorType::eStorageBufferDynamic;
+}
+
+static void check_array_range(const hpxc::DescriptorInfo& descriptor_info,
+                              const uint32_t first_array_element,
+                              const size_t element_count) {
+  if (descriptor_info.count != 0U &&
+      first_array_element + element_count > descriptor_info.count) {
+    throw std::runtime_error("array elements are out of descriptor array.");
+  }
+}
+
+hpxc::gpu::DescriptorWriter::DescriptorWriter(const size_t max_buffer_infos,
+                                              const size_t max_image_infos) {
+  // never reallocated, so that pointers in writes are stable
+  m_bufferInfos.reserve(max_buffer_infos);
+  m_imageInfos.reserve(max_image_infos);
+  m_writeDescriptorSets.reserve(max_buffer_infos + max_image_infos);
+}
+
+hpxc::gpu::DescriptorWriter::~DescriptorWriter() {}
+
+vk::WriteDescriptorSet& hpxc::gpu::DescriptorWriter::addWrite(
+    const uint32_t binding, const vk::DescriptorType descriptor_type,
+    const uint32_t array_element, const uint32_t descriptor_count) {
+  auto& write_descriptor_set = m_writeDescriptorSets.emplace_back();
+  write_descriptor_set.setDstBinding(binding);
+  write_descriptor_set.setDstArrayElement(array_element);
+  write_descriptor_set.setDescriptorCount(descriptor_count);
+  write_descriptor_set.setDescriptorType(descriptor_type);
+
+  return write_descriptor_set;
+}
+
+void hpxc::gpu::DescriptorWriter::writeBuffer(
+    const DescriptorInfo& descriptor_info, const Buffer& buffer,
+    const vk::DeviceSize offset, const vk::DeviceSize range) {
+  if (m_bufferInfos.size() == m_bufferInfos.capacity()) {
+    throw std::runtime_error("descriptor writer buffer infos are full.");
+  }
+
+  // dynamic buffer is bound with its block size, offset is given at dispatch
+  const auto buffer_range =
+      range == VK_WHOLE_SIZE && is_dynamic_buffer(descriptor_info.type)
+          ? vk::DeviceSize{descriptor_info.size}
+          : range;
+  const auto& buffer_info =
+      m_bufferInfos.emplace_back(buffer.getBuffer(), offset, buffer_range);
+  addWrite(descriptor_info.binding, descriptor_info.type)
+      .setPBufferInfo(&buffer_info);
+}
+
+void hpxc::gpu::DescriptorWriter::writeImage(
+    const DescriptorInfo& descriptor_info, const ImageView* ptr_image_view,
+    const ImageLayout dst_image_layout, const Sampler* ptr_sampler) {
+  if (m_imageInfos.size() == m_imageInfos.capacity()) {
+    throw std::runtime_error("descriptor writer image infos are full.");
+  }
+
+  auto& image_info = m_imageInfos.emplace_back();
+  image_info.setImageLayout(vk_helper::getImageLayout(dst_image_layout));
+  if (ptr_image_view != nullptr) {
+    image_info.setImageView(ptr_image_view->getImageView().get());
+  }
+  if (ptr_sampler != nullptr) {
+    image_info.setSampler(ptr_sampler->getSampler().get());
+  }
+
+  addWrite(descriptor_info.binding, descriptor_info.type)
+      .setPImageInfo(&image_info);
+}
+
+void hpxc::gpu::DescriptorWriter::writeBuffers(
+    const DescriptorInfo& descriptor_info,
+    std::span<const Buffer* const> ptr_buffers,
+    const uint32_t first_array_element) {
+  if (ptr_buffers.empty()) {
+    return;
+  }
+  check_array_range(descriptor_info, first_array_element, ptr_buffers.size());
+  if (m_bufferInfos.size() + ptr_buffers.size() > m_bufferInfos.capacity()) {
+    throw std::runtime_error("descriptor writer buffer infos are full.");
+  }
+
+  const auto range = is_dynamic_buffer(descriptor_info.type)
+                         ? vk::DeviceSize{descriptor_info.size}
+                         : VK_WHOLE_SIZE;
+
+  // infos of one write must be contiguous
+  const auto& first_buffer_info = m_bufferInfos.emplace_back(
+      ptr_buffers.front()->getBuffer(), 0U, range);
+  for (const auto ptr_buffer : ptr_buffers.subspan(1U)) {
+    m_bufferInfos.emplace_back(ptr_buffer->getBuffer(), 0U, range);
+  }
+
+  addWrite(descriptor_info.binding, descriptor_info.type, first_array_element,
+           static_cast<uint32_t>(ptr_buffers.size()))
+      .setPBufferInfo(&first_buffer_info);
+}
+
+void hpxc::gpu::DescriptorWriter::writeImages(
+    const DescriptorInfo& descriptor_info,
+    std::span<const ImageView* const> ptr_image_views,
+    const ImageLayout dst_image_layout, const Sampler* ptr_sampler,
+    const uint32_t first_array_element) {
+  if (ptr_image_views.empty()) {
+    return;
+  }
+  check_array_range(descriptor_info, first_array_element,
+                    ptr_image_views.size());
+  if (m_imageInfos.size() + ptr_image_views.size() >
+      m_imageInfos.capacity()) {
+    throw std::runtime_error("descriptor writer image infos are full.");
+  }
+
+  const auto first_index = m_imageInfos.size();
+  for (const auto ptr_image_view : ptr_image_views) {
+    auto& image_info = m_imageInfos.emplace_back();
+    image_info.setImageLayout(vk_helper::getImageLayout(dst_image_layout));
+    image_info.setImageView(ptr_image_view->getImageView().get());
+    if (ptr_sampler != nullptr) {
+      image_info.setSampler(ptr_sampler->getSampler().get());
+    }
+  }
+
+  addWrite(descriptor_info.binding, descriptor_info.type, first_array_element,
+           static_cast<uint32_t>(ptr_image_views.size()))
+      .setPImageInfo(&m_imageInfos.at(first_index));
+}
+
+void hpxc::gpu::DescriptorWriter::write(
+    const BufferDescription& buffer_description) {
+  if (m_bufferInfos.size() == m_bufferInfos.capacity()) {
+    throw std::runtime_error("descriptor writer buffer infos are full.");
+  }
+
+  const auto& buffer_info =
+      m_bufferInfos.emplace_back(buffer_description.getBufferInfo());
+  addWrite(buffer_description.getBinding(),
+           buffer_description.getDescriptorType(),
+           buffer_description.getArrayElement())
+      .setPBufferInfo(&buffer_info);
+}
+
+void hpxc::gpu::DescriptorWriter::write(
+    const ImageDescription& image_description) {
+  if (m_imageInfos.size() == m_imageInfos.capacity()) {
+    throw std::runtime_error("descriptor writer image infos are full.");
+  }
+
+  const auto& image_info =
+      m_imageInfos.emplace_back(image_description.getImageInfo());
+  addWrite(image_description.getBinding(),
+           image_description.getDescriptorType(),
+           image_description.getArrayElement())
+      .setPImageInfo(&image_info);
+}
+
+void hpxc::gpu::DescriptorWriter::flush(
+    const std::unique_ptr<Context>& ptr_context,
+    const DescriptorSet& descriptor_set) {
+  if (m_writeDescriptorSets.empty()) {
+    return;
+  }
+
+  for (auto& write_descriptor_set : m_writeDescriptorSets) {
+    write_descriptor_set.setDstSet(descriptor_set.getDescriptorSet());
+  }
+
+  ptr_context->getDevice()->getLogicalDevice()->updateDescriptorSets(
+      m_writeDescriptorSets, nullptr);
+
+  clear();
+}
+
+void hpxc::gpu::DescriptorWriter::clear() {
+  m_bufferInfos.clear();
+  m_imageInfos.clear();
+  m_writeDescriptorSets.clear();
+}
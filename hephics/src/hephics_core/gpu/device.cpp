@@ -4,6 +4,7 @@
 #include <string>
 
 #include "../gpu.hpp"
+#include "vk_helper.hpp"
 
 std::vector<const char*> g_device_extensions = {
     // VK_KHR_SWAPCHAIN_EXTENSION_NAME,
@@ -11,6 +12,14 @@ std::vector<const char*> g_device_extensions = {
     VK_KHR_SHADER_NON_SEMANTIC_INFO_EXTENSION_NAME,
 };
 
+// enabled only when the physical device supports them
+std::vector<const char*> g_optional_device_extensions = {
+    VK_EXT_SUBGROUP_SIZE_CONTROL_EXTENSION_NAME,
+    VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME,
+    VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME,
+    VK_EXT_HOST_IMAGE_COPY_EXTENSION_NAME,
+};
+
 struct QueueFamilyIndices {
   std::optional<uint32_t> graphics;
   std::optional<uint32_t> compute;
@@ -174,21 +183,226 @@ void hpxc::gpu::Device::constructLogicalDevice(
     }
   }
 
+  auto device_extensions = g_device_extensions;
+  for (const auto& extension_name : g_optional_device_extensions) {
+    if (check_device_extension_support(m_physicalDevice, {extension_name})) {
+      device_extensions.push_back(extension_name);
+      m_enabledExtensions.insert(extension_name);
+    }
+  }
+
   // Create timeline semaphore
   vk::PhysicalDeviceTimelineSemaphoreFeatures timeline_semaphore_features;
   timeline_semaphore_features.setTimelineSemaphore(VK_TRUE);
 
+  // optional features are chained behind the timeline semaphore feature
+  void* ptr_optional_features = nullptr;
+
+  // Enable subgroup size control, if supported
+  vk::PhysicalDeviceSubgroupSizeControlFeatures subgroup_size_features;
+  if (isExtensionEnabled(VK_EXT_SUBGROUP_SIZE_CONTROL_EXTENSION_NAME)) {
+    const auto supported_features = m_physicalDevice.getFeatures2<
+        vk::PhysicalDeviceFeatures2,
+        vk::PhysicalDeviceSubgroupSizeControlFeatures>();
+    subgroup_size_features =
+        supported_features.get<vk::PhysicalDeviceSubgroupSizeControlFeatures>();
+
+    subgroup_size_features.setPNext(ptr_optional_features);
+    ptr_optional_features = &subgroup_size_features;
+  }
+
+  // Enable descriptor indexing for bindless resources, if supported
+  // (core in vulkan 1.2)
+  vk::PhysicalDeviceDescriptorIndexingFeatures descriptor_indexing_features;
+  if (isExtensionEnabled(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME) ||
+      m_physicalDevice.getProperties().apiVersion >= VK_API_VERSION_1_2) {
+    const auto supported_features = m_physicalDevice.getFeatures2<
+        vk::PhysicalDeviceFeatures2,
+        vk::PhysicalDeviceDescriptorIndexingFeatures>();
+    const auto& supported =
+        supported_features.get<vk::PhysicalDeviceDescriptorIndexingFeatures>();
+
+    m_isBindlessSupported =
+        supported.runtimeDescriptorArray &&
+        supported.descriptorBindingPartiallyBound &&
+        supported.descriptorBindingVariableDescriptorCount &&
+        supported.descriptorBindingUpdateUnusedWhilePending &&
+        supported.descriptorBindingSampledImageUpdateAfterBind &&
+        supported.descriptorBindingStorageImageUpdateAfterBind &&
+        supported.descriptorBindingStorageBufferUpdateAfterBind &&
+        supported.shaderSampledImageArrayNonUniformIndexing &&
+        supported.shaderStorageImageArrayNonUniformIndexing &&
+        supported.shaderStorageBufferArrayNonUniformIndexing;
+
+    if (m_isBindlessSupported) {
+      descriptor_indexing_features.setRuntimeDescriptorArray(VK_TRUE);
+      descriptor_indexing_features.setDescriptorBindingPartiallyBound(VK_TRUE);
+      descriptor_indexing_features
+          .setDescriptorBindingVariableDescriptorCount(VK_TRUE);
+      descriptor_indexing_features
+          .setDescriptorBindingUpdateUnusedWhilePending(VK_TRUE);
+      descriptor_indexing_features
+          .setDescriptorBindingSampledImageUpdateAfterBind(VK_TRUE);
+      descriptor_indexing_features
+          .setDescriptorBindingStorageImageUpdateAfterBind(VK_TRUE);
+      descriptor_indexing_features
+          .setDescriptorBindingStorageBufferUpdateAfterBind(VK_TRUE);
+      descriptor_indexing_features
+          .setShaderSampledImageArrayNonUniformIndexing(VK_TRUE);
+      descriptor_indexing_features
+          .setShaderStorageImageArrayNonUniformIndexing(VK_TRUE);
+      descriptor_indexing_features
+          .setShaderStorageBufferArrayNonUniformIndexing(VK_TRUE);
+
+      descriptor_indexing_features.setPNext(ptr_optional_features);
+      ptr_optional_features = &descriptor_indexing_features;
+    }
+  }
+
+  // Enable host image copy, if supported
+  vk::PhysicalDeviceHostImageCopyFeaturesEXT host_image_copy_features;
+  if (isExtensionEnabled(VK_EXT_HOST_IMAGE_COPY_EXTENSION_NAME)) {
+    const auto supported_features = m_physicalDevice.getFeatures2<
+        vk::PhysicalDeviceFeatures2,
+        vk::PhysicalDeviceHostImageCopyFeaturesEXT>();
+    m_isHostImageCopySupported =
+        supported_features.get<vk::PhysicalDeviceHostImageCopyFeaturesEXT>()
+            .hostImageCopy == VK_TRUE;
+
+    if (m_isHostImageCopySupported) {
+      host_image_copy_features.setHostImageCopy(VK_TRUE);
+
+      host_image_copy_features.setPNext(ptr_optional_features);
+      ptr_optional_features = &host_image_copy_features;
+    }
+  }
+
+  timeline_semaphore_features.setPNext(ptr_optional_features);
+
   vk::PhysicalDeviceFeatures2 features2;
   features2.setPNext(&timeline_semaphore_features);
 
+  // storage image of r16f, rg16f, r16, etc... requires extended formats
+  if (m_physicalDevice.getFeatures().shaderStorageImageExtendedFormats) {
+    features2.features.setShaderStorageImageExtendedFormats(VK_TRUE);
+  }
+
+  // storage image declared without format (ex> bindless image array)
+  m_isStorageImageWithoutFormatSupported =
+      m_physicalDevice.getFeatures().shaderStorageImageReadWithoutFormat &&
+      m_physicalDevice.getFeatures().shaderStorageImageWriteWithoutFormat;
+  if (m_isStorageImageWithoutFormatSupported) {
+    features2.features.setShaderStorageImageReadWithoutFormat(VK_TRUE);
+    features2.features.setShaderStorageImageWriteWithoutFormat(VK_TRUE);
+  }
+
   vk::DeviceCreateInfo create_info({}, queue_create_infos, {},
-                                   g_device_extensions, nullptr, &features2);
+                                   device_extensions, nullptr, &features2);
 
 #ifdef HEPHICS_DEBUG
   create_info.setPEnabledLayerNames(ptr_messenger->getValidationLayers());
 #endif
 
   m_ptrLogicalDevice = m_physicalDevice.createDeviceUnique(create_info);
+
+  querySubgroupProperties();
+  if (m_isHostImageCopySupported) {
+    queryHostImageCopyLayouts();
+  }
+
+  m_subgroupProperties.size_control =
+      subgroup_size_features.subgroupSizeControl == VK_TRUE;
+  m_subgroupProperties.compute_full_subgroups =
+      subgroup_size_features.computeFullSubgroups == VK_TRUE;
+}
+
+void hpxc::gpu::Device::querySubgroupProperties() {
+  const auto properties = m_physicalDevice.getProperties2<
+      vk::PhysicalDeviceProperties2, vk::PhysicalDeviceSubgroupProperties>();
+  const auto& subgroup_properties =
+      properties.get<vk::PhysicalDeviceSubgroupProperties>();
+
+  m_subgroupProperties.size = subgroup_properties.subgroupSize;
+  m_subgroupProperties.supported_stages = subgroup_properties.supportedStages;
+  m_subgroupProperties.supported_operations =
+      subgroup_properties.supportedOperations;
+  m_subgroupProperties.quad_operations_in_all_stages =
+      subgroup_properties.quadOperationsInAllStages == VK_TRUE;
+
+  if (!isExtensionEnabled(VK_EXT_SUBGROUP_SIZE_CONTROL_EXTENSION_NAME)) {
+    return;
+  }
+
+  // the structure is valid only when the extension is supported
+  const auto size_control_properties = m_physicalDevice.getProperties2<
+      vk::PhysicalDeviceProperties2,
+      vk::PhysicalDeviceSubgroupSizeControlProperties>();
+  const auto& size_properties =
+      size_control_properties
+          .get<vk::PhysicalDeviceSubgroupSizeControlProperties>();
+
+  m_subgroupProperties.min_size = size_properties.minSubgroupSize;
+  m_subgroupProperties.max_size = size_properties.maxSubgroupSize;
+  m_subgroupProperties.required_size_stages =
+      size_properties.requiredSubgroupSizeStages;
+}
+
+void hpxc::gpu::Device::queryHostImageCopyLayouts() {
+  // first call gets the layout counts, second call fills the layouts
+  vk::PhysicalDeviceHostImageCopyPropertiesEXT host_image_copy_properties;
+  vk::PhysicalDeviceProperties2 properties;
+  properties.setPNext(&host_image_copy_properties);
+  m_physicalDevice.getProperties2(&properties);
+
+  std::vector<vk::ImageLayout> src_layouts(
+      host_image_copy_properties.copySrcLayoutCount);
+  std::vector<vk::ImageLayout> dst_layouts(
+      host_image_copy_properties.copyDstLayoutCount);
+  host_image_copy_properties.setCopySrcLayouts(src_layouts);
+  host_image_copy_properties.setCopyDstLayouts(dst_layouts);
+  m_physicalDevice.getProperties2(&properties);
+
+  m_hostCopySrcLayouts.insert(src_layouts.begin(), src_layouts.end());
+  m_hostCopyDstLayouts.insert(dst_layouts.begin(), dst_layouts.end());
+}
+
+bool hpxc::gpu::Device::isHostImageCopySupported(
+    const vk::Format format) const {
+  if (!m_isHostImageCopySupported) {
+    return false;
+  }
+
+  const auto format_properties = m_physicalDevice.getFormatProperties2<
+      vk::FormatProperties2, vk::FormatProperties3>(format);
+
+  return static_cast<bool>(
+      format_properties.get<vk::FormatProperties3>().optimalTilingFeatures &
+      vk::FormatFeatureFlagBits2::eHostImageTransferEXT);
+}
+
+vk::FormatFeatureFlags hpxc::gpu::Device::getFormatFeatures(
+    const vk::Format format) const {
+  return m_physicalDevice.getFormatProperties(format).optimalTilingFeatures;
+}
+
+bool hpxc::gpu::Device::isFormatSupported(
+    const ImageFormat format,
+    const std::vector<FormatFeature>& features) const {
+  vk::FormatFeatureFlags required_features{};
+  for (const auto& feature : features) {
+    required_features |= vk_helper::getFormatFeatureFlags(feature);
+  }
+
+  return (getFormatFeatures(vk_helper::getImageFormat(format)) &
+          required_features) == required_features;
+}
+
+bool hpxc::gpu::Device::isSubgroupSupported(
+    const vk::SubgroupFeatureFlags operations,
+    const vk::ShaderStageFlagBits stage) const {
+  return (m_subgroupProperties.supported_stages & stage) &&
+         (m_subgroupProperties.supported_operations & operations) ==
+             operations;
 }
 
 const uint32_t hpxc::gpu::Device::getQueueFamilyIndex(
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <cstring>
+
 #include "../gpu.hpp"
 #include "vk_helper.hpp"
 
@@ -35,11 +38,39 @@ static vk::ImageUsageFlagBits get_image_usage(
       return vk::ImageUsageFlagBits::eTransientAttachment;
     case ImageUsage::InputAttachment:
       return vk::ImageUsageFlagBits::eInputAttachment;
+    case ImageUsage::HostTransfer:
+      return vk::ImageUsageFlagBits::eHostTransferEXT;
     default:
       return vk::ImageUsageFlagBits::eSampled;
   }
 }
 
+// format features required by image usage flags
+static vk::FormatFeatureFlags get_required_format_features(
+    const vk::ImageUsageFlags usage_flags) {
+  vk::FormatFeatureFlags format_features{};
+  if (usage_flags & vk::ImageUsageFlagBits::eTransferSrc) {
+    format_features |= vk::FormatFeatureFlagBits::eTransferSrc;
+  }
+  if (usage_flags & vk::ImageUsageFlagBits::eTransferDst) {
+    format_features |= vk::FormatFeatureFlagBits::eTransferDst;
+  }
+  if (usage_flags & vk::ImageUsageFlagBits::eSampled) {
+    format_features |= vk::FormatFeatureFlagBits::eSampledImage;
+  }
+  if (usage_flags & vk::ImageUsageFlagBits::eStorage) {
+    format_features |= vk::FormatFeatureFlagBits::eStorageImage;
+  }
+  if (usage_flags & vk::ImageUsageFlagBits::eColorAttachment) {
+    format_features |= vk::FormatFeatureFlagBits::eColorAttachment;
+  }
+  if (usage_flags & vk::ImageUsageFlagBits::eDepthStencilAttachment) {
+    format_features |= vk::FormatFeatureFlagBits::eDepthStencilAttachment;
+  }
+
+  return format_features;
+}
+
 static vk::ImageType get_image_type(hpxc::ImageDimension dimension) {
   using ImageDimension = hpxc::ImageDimension;
 
@@ -79,8 +110,95 @@ static vk::SampleCountFlagBits get_sample_Count(
   }
 }
 
+static vk::ImageSubresourceLayers get_subresource_layers(
+    const hpxc::ImageViewInfo& image_view_info) {
+  return vk::ImageSubresourceLayers(
+      vk_helper::getImageAspectFlags(image_view_info.aspect),
+      image_view_info.base_mip_level, image_view_info.base_array_layer,
+      image_view_info.array_layers);
+}
+
+static vk::ImageSubresourceRange get_subresource_range(
+    const hpxc::ImageViewInfo& image_view_info) {
+  return vk::ImageSubresourceRange(
+      vk_helper::getImageAspectFlags(image_view_info.aspect),
+      image_view_info.base_mip_level, 1U, image_view_info.base_array_layer,
+      image_view_info.array_layers);
+}
+
+static vk::Extent3D get_mip_extent(const hpxc::gpu::Image& image,
+                                   const uint32_t mip_level) {
+  const auto& graphical_size = image.getGraphicalSize();
+
+  return vk::Extent3D(std::max(graphical_size.width >> mip_level, 1U),
+                      std::max(graphical_size.height >> mip_level, 1U),
+                      std::max(graphical_size.depth >> mip_level, 1U));
+}
+
+// byte size of host memory which the subresource copy accesses
+static size_t get_host_copy_size(const hpxc::gpu::Image& image,
+                                 const hpxc::ImageViewInfo& image_view_info,
+                                 const uint32_t row_length,
+                                 const uint32_t image_height) {
+  const auto texel_size = vk_helper::getTexelSize(image.getFormat());
+  if (texel_size == 0U) {
+    throw std::runtime_error("texel size is unknown for host copy: " +
+                             vk::to_string(image.getFormat()));
+  }
+
+  const auto extent = get_mip_extent(image, image_view_info.base_mip_level);
+  if ((row_length != 0U && row_length < extent.width) ||
+      (image_height != 0U && image_height < extent.height)) {
+    throw std::runtime_error(
+        "row length and image height must not be less than the extent.");
+  }
+
+  const size_t row_pitch = row_length != 0U ? row_length : extent.width;
+  const size_t slice_rows = image_height != 0U ? image_height : extent.height;
+  const size_t slice_count =
+      static_cast<size_t>(extent.depth) * image_view_info.array_layers;
+
+  // the last row needs only its texels, not the whole pitch
+  return ((slice_count - 1U) * slice_rows + (extent.height - 1U)) *
+             row_pitch * texel_size +
+         static_cast<size_t>(extent.width) * texel_size;
+}
+
+// record commands by record_function, submit them to compute queue,
+//   and wait for the completion
+template <typename F>
+static void submit_and_wait(
+    const std::unique_ptr<hpxc::gpu::Context>& ptr_context,
+    F record_function) {
+  const auto& ptr_device = ptr_context->getDevice();
+  const auto& ptr_logical_device = ptr_device->getLogicalDevice();
+  const auto queue_family_index =
+      ptr_device->getQueueFamilyIndex(hpxc::QueueFamilyType::Compute);
+
+  const auto ptr_command_pool = ptr_logical_device->createCommandPoolUnique(
+      vk::CommandPoolCreateInfo(vk::CommandPoolCreateFlagBits::eTransient,
+                                queue_family_index));
+  auto ptr_command_buffers = ptr_logical_device->allocateCommandBuffersUnique(
+      vk::CommandBufferAllocateInfo(ptr_command_pool.get(),
+                                    vk::CommandBufferLevel::ePrimary, 1U));
+  const auto command_buffer = ptr_command_buffers.front().get();
+
+  command_buffer.begin(vk::CommandBufferBeginInfo(
+      vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+  record_function(command_buffer);
+  command_buffer.end();
+
+  const auto ptr_fence = ptr_logical_device->createFenceUnique({});
+  ptr_device->getQueue(queue_family_index)
+      .submit(vk::SubmitInfo({}, {}, command_buffer), ptr_fence.get());
+
+  if (ptr_logical_device->waitForFences(ptr_fence.get(), VK_TRUE,
+                                        UINT64_MAX) != vk::Result::eSuccess) {
+    throw std::runtime_error("failed to wait for image copy.");
+  }
+}
+
 hpxc::gpu::Image::Image(const std::unique_ptr<Context>& ptr_context,
-                        const MemoryUsage memory_usage,
                         const TransferType transfer_type,
                         const std::vector<ImageUsage>& image_usages,
                         const ImageSubInfo& image_sub_info) {
@@ -95,13 +213,30 @@ hpxc::gpu::Image::Image(const std::unique_ptr<Context>& ptr_context,
         vk_image_usages |= get_image_usage(image_usage);
       }
 
-      image_info.setUsage(vk_transfer_type | vk_image_usages);
+      m_usageFlags = vk_transfer_type | vk_image_usages;
+      image_info.setUsage(m_usageFlags);
     }
 
     {
       const vk::Format vk_format =
           vk_helper::getImageFormat(image_sub_info.format);
 
+      // host image copy is optional, staging buffer is used without it
+      if ((m_usageFlags & vk::ImageUsageFlagBits::eHostTransferEXT) &&
+          !ptr_context->getDevice()->isHostImageCopySupported(vk_format)) {
+        m_usageFlags &= ~vk::ImageUsageFlagBits::eHostTransferEXT;
+        image_info.setUsage(m_usageFlags);
+      }
+
+      // ex> rgba32f isn't always usable as storage image
+      m_formatFeatures = ptr_context->getDevice()->getFormatFeatures(vk_format);
+      const auto required_features = get_required_format_features(m_usageFlags);
+      if ((m_formatFeatures & required_features) != required_features) {
+        throw std::runtime_error(
+            "image format is not supported for the image usage: " +
+            vk::to_string(vk_format));
+      }
+
       image_info.setFormat(vk_format);
       m_format = vk_format;
     }
@@ -136,12 +271,16 @@ hpxc::gpu::Image::Image(const std::unique_ptr<Context>& ptr_context,
         ptr_context->getDevice()->getLogicalDevice()->createImageUnique(
             image_info);
   }
+}
 
+hpxc::gpu::Image::Image(const std::unique_ptr<Context>& ptr_context,
+                        const MemoryUsage memory_usage,
+                        const TransferType transfer_type,
+                        const std::vector<ImageUsage>& image_usages,
+                        const ImageSubInfo& image_sub_info)
+    : Image(ptr_context, transfer_type, image_usages, image_sub_info) {
   {
-    const auto memory_requirements =
-        ptr_context->getDevice()
-            ->getLogicalDevice()
-            ->getImageMemoryRequirements(m_ptrImage.get());
+    const auto memory_requirements = getMemoryRequirements(ptr_context);
 
     const vk::MemoryPropertyFlags vk_memory_usage =
         vk_helper::getMemoryPropertyFlags(memory_usage);
@@ -173,3 +312,183 @@ hpxc::gpu::Image::Image(const std::unique_ptr<Context>& ptr_context,
 }
 
 hpxc::gpu::Image::~Image() {}
+
+vk::MemoryRequirements hpxc::gpu::Image::getMemoryRequirements(
+    const std::unique_ptr<Context>& ptr_context) const {
+  return ptr_context->getDevice()
+      ->getLogicalDevice()
+      ->getImageMemoryRequirements(m_ptrImage.get());
+}
+
+void hpxc::gpu::Image::bindMemory(const std::unique_ptr<Context>& ptr_context,
+                                  const vk::DeviceMemory memory,
+                                  const vk::DeviceSize offset) const {
+  if (m_ptrMemory) {
+    throw std::runtime_error("image already has its own memory.");
+  }
+
+  ptr_context->getDevice()->getLogicalDevice()->bindImageMemory(
+      m_ptrImage.get(), memory, offset);
+}
+
+void hpxc::gpu::Image::copyFromHost(
+    const std::unique_ptr<Context>& ptr_context, const void* ptr_data,
+    const size_t size, const ImageViewInfo& image_view_info,
+    const ImageLayout dst_layout, const uint32_t row_length,
+    const uint32_t image_height) const {
+  const auto& ptr_device = ptr_context->getDevice();
+  const auto vk_dst_layout = vk_helper::getImageLayout(dst_layout);
+  const auto subresource_range = get_subresource_range(image_view_info);
+  const auto image_extent =
+      get_mip_extent(*this, image_view_info.base_mip_level);
+
+  const auto required_size =
+      get_host_copy_size(*this, image_view_info, row_length, image_height);
+  if (size < required_size) {
+    throw std::runtime_error("host data is smaller than the subresource: " +
+                             std::to_string(required_size) + " bytes.");
+  }
+
+  if (isHostCopyable() &&
+      ptr_device->getHostCopyDstLayouts().contains(vk_dst_layout)) {
+    // subresource is overwritten, so its contents needn't be kept
+    vk::HostImageLayoutTransitionInfoEXT transition_info(
+        m_ptrImage.get(), vk::ImageLayout::eUndefined, vk_dst_layout,
+        subresource_range);
+    ptr_device->getLogicalDevice()->transitionImageLayoutEXT(transition_info);
+
+    // zero row length and image height mean tightly packed
+    vk::MemoryToImageCopyEXT copy_region(
+        ptr_data, row_length, image_height,
+        get_subresource_layers(image_view_info), {0, 0, 0}, image_extent);
+    vk::CopyMemoryToImageInfoEXT copy_info({}, m_ptrImage.get(),
+                                           vk_dst_layout, copy_region);
+    ptr_device->getLogicalDevice()->copyMemoryToImageEXT(copy_info);
+
+    return;
+  }
+
+  if (!(m_usageFlags & vk::ImageUsageFlagBits::eTransferDst)) {
+    throw std::runtime_error(
+        "image needs TransferDst usage to be copied by staging buffer.");
+  }
+
+  Buffer staging_buffer(ptr_context, MemoryUsage::CpuToGpu,
+                        TransferType::TransferSrc,
+                        {BufferUsage::StagingBuffer}, size);
+  // CpuToGpu memory isn't always host coherent
+  std::memcpy(staging_buffer.mapMemory(ptr_context), ptr_data, size);
+  staging_buffer.flushMemory(ptr_context);
+  staging_buffer.unmapMemory(ptr_context);
+
+  submit_and_wait(ptr_context, [&](const vk::CommandBuffer command_buffer) {
+    vk::ImageMemoryBarrier barrier(
+        {}, vk::AccessFlagBits::eTransferWrite, vk::ImageLayout::eUndefined,
+        vk::ImageLayout::eTransferDstOptimal, VK_QUEUE_FAMILY_IGNORED,
+        VK_QUEUE_FAMILY_IGNORED, m_ptrImage.get(), subresource_range);
+    command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe,
+                                   vk::PipelineStageFlagBits::eTransfer, {},
+                                   nullptr, nullptr, barrier);
+
+    // staging buffer keeps the host rows as they are
+    vk::BufferImageCopy copy_region(0U, row_length, image_height,
+                                    get_subresource_layers(image_view_info),
+                                    {0, 0, 0}, image_extent);
+    command_buffer.copyBufferToImage(staging_buffer.getBuffer(),
+                                     m_ptrImage.get(),
+                                     vk::ImageLayout::eTransferDstOptimal,
+                                     copy_region);
+
+    // queue submission waits for the fence, so that no dst access is needed
+    barrier.setSrcAccessMask(vk::AccessFlagBits::eTransferWrite);
+    barrier.setDstAccessMask({});
+    barrier.setOldLayout(vk::ImageLayout::eTransferDstOptimal);
+    barrier.setNewLayout(vk_dst_layout);
+    command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                                   vk::PipelineStageFlagBits::eBottomOfPipe,
+                                   {}, nullptr, nullptr, barrier);
+  });
+}
+
+void hpxc::gpu::Image::copyToHost(const std::unique_ptr<Context>& ptr_context,
+                                  void* ptr_data, const size_t size,
+                                  const ImageViewInfo& image_view_info,
+                                  const ImageLayout src_layout,
+                                  const uint32_t row_length,
+                                  const uint32_t image_height) const {
+  const auto& ptr_device = ptr_context->getDevice();
+  const auto vk_src_layout = vk_helper::getImageLayout(src_layout);
+  const auto subresource_range = get_subresource_range(image_view_info);
+  const auto image_extent =
+      get_mip_extent(*this, image_view_info.base_mip_level);
+
+  const auto required_size =
+      get_host_copy_size(*this, image_view_info, row_length, image_height);
+  if (size < required_size) {
+    throw std::runtime_error("host data is smaller than the subresource: " +
+                             std::to_string(required_size) + " bytes.");
+  }
+
+  if (isHostCopyable() &&
+      ptr_device->getHostCopySrcLayouts().contains(vk_src_layout)) {
+    vk::ImageToMemoryCopyEXT copy_region(
+        ptr_data, row_length, image_height,
+        get_subresource_layers(image_view_info), {0, 0, 0}, image_extent);
+    vk::CopyImageToMemoryInfoEXT copy_info({}, m_ptrImage.get(),
+                                           vk_src_layout, copy_region);
+    ptr_device->getLogicalDevice()->copyImageToMemoryEXT(copy_info);
+
+    return;
+  }
+
+  if (!(m_usageFlags & vk::ImageUsageFlagBits::eTransferSrc)) {
+    throw std::runtime_error(
+        "image needs TransferSrc usage to be copied by staging buffer.");
+  }
+
+  Buffer staging_buffer(ptr_context, MemoryUsage::GpuToCpu,
+                        TransferType::TransferDst,
+                        {BufferUsage::StagingBuffer}, size);
+
+  submit_and_wait(ptr_context, [&](const vk::CommandBuffer command_buffer) {
+    vk::ImageMemoryBarrier barrier(
+        vk::AccessFlagBits::eMemoryWrite, vk::AccessFlagBits::eTransferRead,
+        vk_src_layout, vk::ImageLayout::eTransferSrcOptimal,
+        VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, m_ptrImage.get(),
+        subresource_range);
+    command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands,
+                                   vk::PipelineStageFlagBits::eTransfer, {},
+                                   nullptr, nullptr, barrier);
+
+    // staging buffer keeps the host rows as they are
+    vk::BufferImageCopy copy_region(0U, row_length, image_height,
+                                    get_subresource_layers(image_view_info),
+                                    {0, 0, 0}, image_extent);
+    command_buffer.copyImageToBuffer(m_ptrImage.get(),
+                                     vk::ImageLayout::eTransferSrcOptimal,
+                                     staging_buffer.getBuffer(), copy_region);
+
+    // back to the original layout, and make the copy visible to host
+    barrier.setSrcAccessMask(vk::AccessFlagBits::eTransferRead);
+    barrier.setDstAccessMask({});
+    barrier.setOldLayout(vk::ImageLayout::eTransferSrcOptimal);
+    barrier.setNewLayout(vk_src_layout);
+    command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                                   vk::PipelineStageFlagBits::eBottomOfPipe,
+                                   {}, nullptr, nullptr, barrier);
+
+    const vk::BufferMemoryBarrier buffer_barrier(
+        vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eHostRead,
+        VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+        staging_buffer.getBuffer(), 0U, VK_WHOLE_SIZE);
+    command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                                   vk::PipelineStageFlagBits::eHost, {},
+                                   nullptr, buffer_barrier, nullptr);
+  });
+
+  // GpuToCpu memory is host cached, not coherent
+  const auto ptr_staging_data = staging_buffer.mapMemory(ptr_context);
+  staging_buffer.invalidateMemory(ptr_context);
+  std::memcpy(ptr_data, ptr_staging_data, size);
+  staging_buffer.unmapMemory(ptr_context);
+}
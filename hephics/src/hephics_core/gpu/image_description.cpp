@@ -3,48 +3,46 @@
 
 hpxc::gpu::ImageDescription::ImageDescription(
     const DescriptorInfo& descriptor_info, const ImageView& image_view,
-    const ImageLayout dst_image_layout) {
-  m_ptrImageInfo = std::make_shared<vk::DescriptorImageInfo>();
-  m_ptrWriteDescriptorSet = std::make_shared<vk::WriteDescriptorSet>();
-
-  m_ptrImageInfo->setImageLayout(vk_helper::getImageLayout(dst_image_layout));
-  m_ptrImageInfo->setImageView(image_view.getImageView().get());
-
-  m_ptrWriteDescriptorSet->setDstBinding(descriptor_info.binding);
-  m_ptrWriteDescriptorSet->setDstArrayElement(0U);
-  m_ptrWriteDescriptorSet->setDescriptorType(descriptor_info.type);
-  m_ptrWriteDescriptorSet->setImageInfo(*m_ptrImageInfo);
+    const ImageLayout dst_image_layout, const uint32_t array_element)
+    : m_binding(descriptor_info.binding),
+      m_arrayElement(array_element),
+      m_descriptorType(descriptor_info.type) {
+  if (descriptor_info.count != 0U && array_element >= descriptor_info.count) {
+    throw std::runtime_error("array element is out of descriptor array.");
+  }
+
+  m_imageInfo.setImageLayout(vk_helper::getImageLayout(dst_image_layout));
+  m_imageInfo.setImageView(image_view.getImageView().get());
 }
 
 hpxc::gpu::ImageDescription::ImageDescription(
     const DescriptorInfo& descriptor_info, const ImageLayout dst_image_layout,
-    const Sampler& sampler) {
-  m_ptrImageInfo = std::make_shared<vk::DescriptorImageInfo>();
-  m_ptrWriteDescriptorSet = std::make_shared<vk::WriteDescriptorSet>();
-
-  m_ptrImageInfo->setImageLayout(vk_helper::getImageLayout(dst_image_layout));
-  m_ptrImageInfo->setSampler(sampler.getSampler().get());
-
-  m_ptrWriteDescriptorSet->setDstBinding(descriptor_info.binding);
-  m_ptrWriteDescriptorSet->setDstArrayElement(0U);
-  m_ptrWriteDescriptorSet->setDescriptorType(descriptor_info.type);
-  m_ptrWriteDescriptorSet->setImageInfo(*m_ptrImageInfo);
+    const Sampler& sampler, const uint32_t array_element)
+    : m_binding(descriptor_info.binding),
+      m_arrayElement(array_element),
+      m_descriptorType(descriptor_info.type) {
+  if (descriptor_info.count != 0U && array_element >= descriptor_info.count) {
+    throw std::runtime_error("array element is out of descriptor array.");
+  }
+
+  m_imageInfo.setImageLayout(vk_helper::getImageLayout(dst_image_layout));
+  m_imageInfo.setSampler(sampler.getSampler().get());
 }
 
 hpxc::gpu::ImageDescription::ImageDescription(
     const DescriptorInfo& descriptor_info, const ImageView& image_view,
-    const ImageLayout dst_image_layout, const Sampler& sampler) {
-  m_ptrImageInfo = std::make_shared<vk::DescriptorImageInfo>();
-  m_ptrWriteDescriptorSet = std::make_shared<vk::WriteDescriptorSet>();
-
-  m_ptrImageInfo->setImageLayout(vk_helper::getImageLayout(dst_image_layout));
-  m_ptrImageInfo->setImageView(image_view.getImageView().get());
-  m_ptrImageInfo->setSampler(sampler.getSampler().get());
-
-  m_ptrWriteDescriptorSet->setDstBinding(descriptor_info.binding);
-  m_ptrWriteDescriptorSet->setDstArrayElement(0U);
-  m_ptrWriteDescriptorSet->setDescriptorType(descriptor_info.type);
-  m_ptrWriteDescriptorSet->setImageInfo(*m_ptrImageInfo);
+    const ImageLayout dst_image_layout, const Sampler& sampler,
+    const uint32_t array_element)
+    : m_binding(descriptor_info.binding),
+      m_arrayElement(array_element),
+      m_descriptorType(descriptor_info.type) {
+  if (descriptor_info.count != 0U && array_element >= descriptor_info.count) {
+    throw std::runtime_error("array element is out of descriptor array.");
+  }
+
+  m_imageInfo.setImageLayout(vk_helper::getImageLayout(dst_image_layout));
+  m_imageInfo.setImageView(image_view.getImageView().get());
+  m_imageInfo.setSampler(sampler.getSampler().get());
 }
 
 hpxc::gpu::ImageDescription::~ImageDescription() {}
@@ -0,0 +1,112 @@
+#include <algorithm>
+
+#include "../gpu.hpp"
+
+hpxc::gpu::ImagePool::~ImagePool() {}
+
+const hpxc::gpu::ImagePool::PooledImage& hpxc::gpu::ImagePool::acquire(
+    const std::unique_ptr<Context>& ptr_context,
+    const MemoryUsage memory_usage, const TransferType transfer_type,
+    const std::vector<ImageUsage>& image_usages,
+    const ImageSubInfo& image_sub_info) {
+  // all image formats are color, but the usage may ask for depth
+  if (std::find(image_usages.begin(), image_usages.end(),
+                ImageUsage::DepthStencilAttachment) != image_usages.end()) {
+    throw std::runtime_error("depth stencil image can't be pooled.");
+  }
+
+  ImageKey image_key;
+  image_key.width = image_sub_info.graphical_size.width;
+  image_key.height = image_sub_info.graphical_size.height;
+  image_key.depth = image_sub_info.graphical_size.depth;
+  image_key.mip_levels = image_sub_info.mip_levels;
+  image_key.array_layers = image_sub_info.array_layers;
+  image_key.samples = image_sub_info.samples;
+  image_key.format = image_sub_info.format;
+  image_key.dimension = image_sub_info.dimension;
+  image_key.memory_usage = memory_usage;
+  image_key.transfer_type = transfer_type;
+  for (const auto& image_usage : image_usages) {
+    image_key.usage_bits |= 1U << static_cast<uint32_t>(image_usage);
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  PooledImage pooled_image;
+
+  // oldest released image is most likely retired
+  auto& released_images = m_releasedImageMap[image_key];
+  const auto iter = std::find_if(
+      released_images.begin(), released_images.end(),
+      [&](const ReleasedImage& released_image) {
+        return released_image.last_use_value <= m_retiredValue;
+      });
+  if (iter != released_images.end()) {
+    pooled_image = std::move(iter->pooled_image);
+    released_images.erase(iter);
+  } else {
+    pooled_image.ptr_image =
+        std::make_unique<Image>(ptr_context, memory_usage, transfer_type,
+                                image_usages, image_sub_info);
+
+    ImageViewInfo image_view_info{};
+    image_view_info.aspect = ImageAspect::Color;
+    image_view_info.base_mip_level = 0U;
+    image_view_info.mip_levels = image_sub_info.mip_levels;
+    image_view_info.base_array_layer = 0U;
+    image_view_info.array_layers = image_sub_info.array_layers;
+    image_view_info.is_array = image_sub_info.array_layers > 1U;
+    pooled_image.ptr_image_view = std::make_unique<ImageView>(
+        ptr_context, *pooled_image.ptr_image, image_view_info);
+
+    m_createdImageCount += 1U;
+  }
+
+  const VkImage vk_image = pooled_image.ptr_image->getImage();
+  const auto [used_iter, is_inserted] = m_usedImageMap.emplace(
+      vk_image, std::make_pair(image_key, std::move(pooled_image)));
+
+  return used_iter->second.second;
+}
+
+void hpxc::gpu::ImagePool::release(const Image& image,
+                                   const uint64_t last_use_value) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  const auto iter = m_usedImageMap.find(image.getImage());
+  if (iter == m_usedImageMap.end()) {
+    throw std::runtime_error("image is not acquired from this pool.");
+  }
+
+  auto& [image_key, pooled_image] = iter->second;
+  ReleasedImage released_image;
+  released_image.pooled_image = std::move(pooled_image);
+  released_image.last_use_value = last_use_value;
+  m_releasedImageMap[image_key].push_back(std::move(released_image));
+
+  m_usedImageMap.erase(iter);
+}
+
+void hpxc::gpu::ImagePool::retire(const uint64_t completed_value) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  m_retiredValue = std::max(m_retiredValue, completed_value);
+}
+
+void hpxc::gpu::ImagePool::trim() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  for (auto& [image_key, released_images] : m_releasedImageMap) {
+    std::erase_if(released_images, [&](const ReleasedImage& released_image) {
+      return released_image.last_use_value <= m_retiredValue;
+    });
+  }
+  std::erase_if(m_releasedImageMap,
+                [](const auto& pair) { return pair.second.empty(); });
+}
+
+size_t hpxc::gpu::ImagePool::getCreatedImageCount() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  return m_createdImageCount;
+}
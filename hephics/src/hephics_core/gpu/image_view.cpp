@@ -2,12 +2,12 @@
 #include "vk_helper.hpp"
 
 static vk::ImageViewType get_image_view_type(
-    const hpxc::ImageDimension image_dimension) {
+    const hpxc::ImageDimension image_dimension, const bool is_array) {
   switch (image_dimension) {
     case hpxc::ImageDimension::v1D:
-      return vk::ImageViewType::e1D;
+      return is_array ? vk::ImageViewType::e1DArray : vk::ImageViewType::e1D;
     case hpxc::ImageDimension::v2D:
-      return vk::ImageViewType::e2D;
+      return is_array ? vk::ImageViewType::e2DArray : vk::ImageViewType::e2D;
     case hpxc::ImageDimension::v3D:
       return vk::ImageViewType::e3D;
     default:
@@ -41,7 +41,8 @@ hpxc::gpu::ImageView::ImageView(
     create_info.setComponents(component_mapping);
   }
 
-  create_info.setViewType(get_image_view_type(image.getDimension()));
+  create_info.setViewType(
+      get_image_view_type(image.getDimension(), image_view_info.is_array));
   create_info.setFormat(image.getFormat());
   create_info.setImage(image.getImage());
 
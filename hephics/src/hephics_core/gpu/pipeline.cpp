@@ -1,43 +1,140 @@
+#include <algorithm>
+#include <format>
+
 #include "../gpu.hpp"
 
 hpxc::gpu::Pipeline::Pipeline(
     const std::unique_ptr<Context>& ptr_context,
     const DescriptionUnit& description_unit,
-    const DescriptorSetLayout& descriptor_set_layout) {
+    const DescriptorSetLayout& descriptor_set_layout)
+    : Pipeline(ptr_context, description_unit, {&descriptor_set_layout}) {}
+
+hpxc::gpu::Pipeline::Pipeline(
+    const std::unique_ptr<Context>& ptr_context,
+    const DescriptionUnit& description_unit,
+    const std::vector<const DescriptorSetLayout*>& ptr_descriptor_set_layouts) {
+  std::vector<vk::DescriptorSetLayout> set_layouts;
+  for (const auto ptr_descriptor_set_layout : ptr_descriptor_set_layouts) {
+    const auto set_index = ptr_descriptor_set_layout->getSetIndex();
+    if (set_index >= set_layouts.size()) {
+      set_layouts.resize(set_index + 1U);
+    }
+    if (set_layouts.at(set_index)) {
+      throw std::runtime_error(
+          std::format("descriptor set {} has multiple layouts.", set_index));
+    }
+    set_layouts.at(set_index) =
+        ptr_descriptor_set_layout->getDescriptorSetLayout();
+
+    if (ptr_descriptor_set_layout->isPushDescriptor()) {
+      if (m_pushDescriptorSetIndex.has_value()) {
+        throw std::runtime_error("only one push descriptor set is allowed.");
+      }
+      m_pushDescriptorSetIndex = set_index;
+    }
+  }
+
+  // pipeline layout needs a valid layout for every set below the highest
+  for (auto& set_layout : set_layouts) {
+    if (!set_layout) {
+      set_layout = ptr_context->getDescriptorSetLayout({});
+    }
+  }
+
   std::vector<vk::PushConstantRange> push_constant_ranges;
+  uint32_t push_constant_end = 0U;
   for (const auto& [_, push_constant_range] :
        description_unit.getPushConstantRangeMap()) {
-    push_constant_ranges.emplace_back(
+    const auto& vk_range = push_constant_ranges.emplace_back(
         push_constant_range.stage_flags, push_constant_range.offset,
         static_cast<uint32_t>(push_constant_range.size));
-  }
 
-  vk::PipelineLayoutCreateInfo pipeline_layout_info;
-  pipeline_layout_info.setSetLayouts(
-      descriptor_set_layout.getDescriptorSetLayout().get());
-  pipeline_layout_info.setPushConstantRanges(push_constant_ranges);
+    if (push_constant_ranges.size() == 1U ||
+        vk_range.offset < m_pushConstantRange.offset) {
+      m_pushConstantRange.offset = vk_range.offset;
+    }
+    m_pushConstantRange.stageFlags |= vk_range.stageFlags;
+    push_constant_end =
+        std::max(push_constant_end, vk_range.offset + vk_range.size);
+  }
+  if (!push_constant_ranges.empty()) {
+    m_pushConstantRange.size = push_constant_end - m_pushConstantRange.offset;
+  }
 
-  m_ptrPipelineLayout =
-      ptr_context->getDevice()->getLogicalDevice()->createPipelineLayoutUnique(
-          pipeline_layout_info);
+  m_pipelineLayout =
+      ptr_context->getPipelineLayout(set_layouts, push_constant_ranges);
 }
 
 hpxc::gpu::Pipeline::~Pipeline() {}
 
-void hpxc::gpu::Pipeline::constructComputePipeline(
-    const std::unique_ptr<Context>& ptr_context,
-    const ShaderModule& shader_module) {
-  m_queueFamilyType = QueueFamilyType::Compute;
+void hpxc::gpu::Pipeline::setRequiredSubgroupSize(
+    const std::unique_ptr<Context>& ptr_context, const uint32_t subgroup_size,
+    const bool require_full_subgroups) {
+  const auto& subgroup_properties =
+      ptr_context->getDevice()->getSubgroupProperties();
+
+  if (subgroup_size != 0U || require_full_subgroups) {
+    if (!subgroup_properties.size_control) {
+      throw std::runtime_error("subgroup size control is not supported.");
+    }
+  }
 
+  if (subgroup_size != 0U) {
+    const auto is_power_of_two = (subgroup_size & (subgroup_size - 1U)) == 0U;
+    if (!is_power_of_two || subgroup_size < subgroup_properties.min_size ||
+        subgroup_size > subgroup_properties.max_size ||
+        !(subgroup_properties.required_size_stages &
+          vk::ShaderStageFlagBits::eCompute)) {
+      throw std::runtime_error(std::format(
+          "required subgroup size {} is not supported.", subgroup_size));
+    }
+  }
+
+  if (require_full_subgroups && !subgroup_properties.compute_full_subgroups) {
+    throw std::runtime_error("full subgroups are not supported.");
+  }
+
+  m_requiredSubgroupSizeInfo.setRequiredSubgroupSize(subgroup_size);
+
+  m_shaderStageCreateFlags = {};
+  if (require_full_subgroups) {
+    m_shaderStageCreateFlags |=
+        vk::PipelineShaderStageCreateFlagBits::eRequireFullSubgroups;
+  }
+}
+
+vk::ComputePipelineCreateInfo hpxc::gpu::Pipeline::getComputePipelineInfo(
+    const ShaderModule& shader_module,
+    const vk::SpecializationInfo* ptr_specialization_info) const {
   vk::PipelineShaderStageCreateInfo shader_stage_info;
   shader_stage_info.setStage(vk::ShaderStageFlagBits::eCompute);
   shader_stage_info.setModule(shader_module.getModule().get());
   shader_stage_info.setPName(shader_module.getEntryPointName().c_str());
+  shader_stage_info.setPSpecializationInfo(ptr_specialization_info);
+  shader_stage_info.setFlags(m_shaderStageCreateFlags);
+  if (m_requiredSubgroupSizeInfo.requiredSubgroupSize != 0U) {
+    shader_stage_info.setPNext(&m_requiredSubgroupSizeInfo);
+  }
 
   vk::ComputePipelineCreateInfo compute_pipeline_info;
-  compute_pipeline_info.setLayout(m_ptrPipelineLayout.get());
+  compute_pipeline_info.setLayout(m_pipelineLayout);
   compute_pipeline_info.setStage(shader_stage_info);
 
+  return compute_pipeline_info;
+}
+
+void hpxc::gpu::Pipeline::constructComputePipeline(
+    const std::unique_ptr<Context>& ptr_context,
+    const ShaderModule& shader_module,
+    const SpecializationValueMap& specialization_values) {
+  m_queueFamilyType = QueueFamilyType::Compute;
+
+  const Specialization specialization(shader_module, specialization_values);
+  const auto specialization_info = specialization.getSpecializationInfo();
+
+  const auto compute_pipeline_info = getComputePipelineInfo(
+      shader_module, specialization.isEmpty() ? nullptr : &specialization_info);
+
   m_ptrPipeline =
       ptr_context->getDevice()
           ->getLogicalDevice()
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <format>
+#include <tuple>
+
+#include "../gpu.hpp"
+
+static std::string make_variant_key(
+    const hpxc::gpu::DescriptionUnit& description_unit,
+    const hpxc::gpu::DescriptorSetLayout& descriptor_set_layout,
+    const hpxc::gpu::ShaderModule& shader_module,
+    const hpxc::gpu::Specialization& specialization) {
+  // code is identified by its content, not by the vulkan handle,
+  //   which may be reused after the module is destroyed
+  std::string key = std::format("{:016x}:{}:", shader_module.getSpirvHash(),
+                                shader_module.getEntryPointName());
+
+  // pipeline layout is made of set layout and push constant ranges.
+  // set layouts are shared by hpxc::gpu::Context, so the handle is stable
+  const auto vk_set_layout = static_cast<VkDescriptorSetLayout>(
+      descriptor_set_layout.getDescriptorSetLayout());
+  key += std::format("{}={:016x}|", descriptor_set_layout.getSetIndex(),
+                     reinterpret_cast<uint64_t>(vk_set_layout));
+
+  std::vector<std::tuple<uint32_t, size_t, VkShaderStageFlags>>
+      push_constant_ranges;
+  for (const auto& [_, push_constant_range] :
+       description_unit.getPushConstantRangeMap()) {
+    push_constant_ranges.emplace_back(
+        push_constant_range.offset, push_constant_range.size,
+        static_cast<VkShaderStageFlags>(push_constant_range.stage_flags));
+  }
+  std::sort(push_constant_ranges.begin(), push_constant_ranges.end());
+  for (const auto& [offset, size, stage_flags] : push_constant_ranges) {
+    key += std::format("{}+{}:{}|", offset, size, stage_flags);
+  }
+
+  for (const auto& map_entry : specialization.getMapEntries()) {
+    key += std::format("{}@{},", map_entry.constantID, map_entry.offset);
+  }
+  key.append(reinterpret_cast<const char*>(specialization.getData().data()),
+             specialization.getData().size());
+
+  return key;
+}
+
+hpxc::gpu::PipelineVariantCache::~PipelineVariantCache() {}
+
+const hpxc::gpu::Pipeline& hpxc::gpu::PipelineVariantCache::getComputePipeline(
+    const std::unique_ptr<Context>& ptr_context,
+    const DescriptionUnit& description_unit,
+    const DescriptorSetLayout& descriptor_set_layout,
+    const ShaderModule& shader_module,
+    const SpecializationValueMap& specialization_values) {
+  const Specialization specialization(shader_module, specialization_values);
+  const auto key = make_variant_key(description_unit, descriptor_set_layout,
+                                    shader_module, specialization);
+
+  {
+    std::shared_lock lock(m_mutex);
+    const auto pipeline_itr = m_pipelineMap.find(key);
+    if (pipeline_itr != m_pipelineMap.end()) {
+      return *pipeline_itr->second;
+    }
+  }
+
+  // pipeline is created outside the lock, not to block other variants
+  auto ptr_pipeline = std::make_unique<Pipeline>(ptr_context, description_unit,
+                                                 descriptor_set_layout);
+  ptr_pipeline->constructComputePipeline(ptr_context, shader_module,
+                                         specialization_values);
+
+  std::unique_lock lock(m_mutex);
+  // if another thread has already created the same variant, it is used
+  const auto [pipeline_itr, _] =
+      m_pipelineMap.try_emplace(key, std::move(ptr_pipeline));
+
+  return *pipeline_itr->second;
+}
+
+size_t hpxc::gpu::PipelineVariantCache::getVariantCount() {
+  std::shared_lock lock(m_mutex);
+
+  return m_pipelineMap.size();
+}
+
+void hpxc::gpu::PipelineVariantCache::clear() {
+  std::unique_lock lock(m_mutex);
+  m_pipelineMap.clear();
+}
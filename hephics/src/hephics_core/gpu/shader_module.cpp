@@ -12,11 +12,23 @@ class ShaderCompiler : public spirv_cross::Compiler {
   vk::ShaderStageFlags getShaderStageFlags() const;
   std::string getEntryPointName() const { return this->get_entry_point().name; }
 
-  std::unordered_map<std::string, hpxc::DescriptorInfo>
-  getDescriptorInfos() const;
+  /// <summary>
+  /// Build whole reflection.
+  /// get_shader_resources() is called only once here.
+  /// </summary>
+  hpxc::ShaderReflection getReflection() const;
+
+ private:
+  std::unordered_map<std::string, hpxc::DescriptorInfo> getDescriptorInfos(
+      const spirv_cross::ShaderResources& resources,
+      const vk::ShaderStageFlags shader_stage_flags) const;
 
   std::unordered_map<std::string, hpxc::PushConstantRange>
-  getPushConstantRanges() const;
+  getPushConstantRanges(const spirv_cross::ShaderResources& resources,
+                        const vk::ShaderStageFlags shader_stage_flags) const;
+
+  std::unordered_map<std::string, hpxc::SpecializationConstantInfo>
+  getSpecializationConstants() const;
 };
 
 vk::ShaderStageFlags ShaderCompiler::getShaderStageFlags() const {
@@ -47,6 +59,24 @@ static uint32_t get_type_size(const spirv_cross::Compiler& compiler,
   return 0U;
 }
 
+static uint32_t get_array_count(const spirv_cross::SPIRType& type) {
+  uint32_t count = 1U;
+  for (size_t idx = 0U; idx < type.array.size(); idx += 1U) {
+    // size given by specialization constant is not supported
+    if (!type.array_size_literal.at(idx)) {
+      throw std::runtime_error(
+          "descriptor array size must be literal in shader.");
+    }
+    // runtime array (ex> uniform image2D images[];)
+    if (type.array.at(idx) == 0U) {
+      return 0U;
+    }
+    count *= type.array.at(idx);
+  }
+
+  return count;
+}
+
 static void set_descriptor_infos(
     std::unordered_map<std::string, hpxc::DescriptorInfo>&
         descriptor_info_map,
@@ -59,6 +89,11 @@ static void set_descriptor_infos(
     descriptor_info.type = descriptor_type;
     descriptor_info.size =
         get_type_size(compiler, compiler.get_type(resource.base_type_id));
+    descriptor_info.count =
+        get_array_count(compiler.get_type(resource.type_id));
+    descriptor_info.is_runtime_array = descriptor_info.count == 0U;
+    descriptor_info.set =
+        compiler.get_decoration(resource.id, spv::DecorationDescriptorSet);
     descriptor_info.binding =
         compiler.get_decoration(resource.id, spv::DecorationBinding);
     descriptor_info.stage_flags = shader_stage_flags;
@@ -68,13 +103,12 @@ static void set_descriptor_infos(
 }
 
 std::unordered_map<std::string, hpxc::DescriptorInfo>
-ShaderCompiler::getDescriptorInfos() const {
+ShaderCompiler::getDescriptorInfos(
+    const spirv_cross::ShaderResources& resources,
+    const vk::ShaderStageFlags shader_stage_flags) const {
   std::unordered_map<std::string, hpxc::DescriptorInfo>
       descriptor_info_map;
 
-  const auto resources = this->get_shader_resources();
-  const auto shader_stage_flags = getShaderStageFlags();
-
   set_descriptor_infos(descriptor_info_map, *this, resources.uniform_buffers,
                        vk::DescriptorType::eUniformBuffer, shader_stage_flags);
   set_descriptor_infos(descriptor_info_map, *this, resources.separate_images,
@@ -93,48 +127,128 @@ ShaderCompiler::getDescriptorInfos() const {
 }
 
 std::unordered_map<std::string, hpxc::PushConstantRange>
-ShaderCompiler::getPushConstantRanges() const {
+ShaderCompiler::getPushConstantRanges(
+    const spirv_cross::ShaderResources& resources,
+    const vk::ShaderStageFlags shader_stage_flags) const {
   std::unordered_map<std::string, hpxc::PushConstantRange>
       push_constant_range_map;
 
-  const auto& resources = this->get_shader_resources();
-  const auto& shader_stage_flags = getShaderStageFlags();
-
-  uint32_t previous_size = 0U;
+  // a shader stage has at most one push constant block,
+  //   and its range begins at the first member's offset
   for (const auto& resource : resources.push_constant_buffers) {
+    const auto& type = this->get_type(resource.base_type_id);
+    const auto offset = type.member_types.empty()
+                            ? 0U
+                            : this->type_struct_member_offset(type, 0U);
+
     hpxc::PushConstantRange push_constant_range;
     push_constant_range.stage_flags = shader_stage_flags;
-    push_constant_range.offset = previous_size;
-    push_constant_range.size =
-        this->get_declared_struct_size(this->get_type(resource.base_type_id));
+    push_constant_range.offset = offset;
+    push_constant_range.size = this->get_declared_struct_size(type) - offset;
 
     push_constant_range_map.insert({resource.name, push_constant_range});
-    previous_size += static_cast<uint32_t>(push_constant_range.size);
   }
 
   return push_constant_range_map;
 }
 
-hpxc::gpu::ShaderModule::ShaderModule(
-    const std::unique_ptr<Context>& ptr_context,
-    const std::vector<uint32_t>& spirv_binary) {
-  {
-    ShaderCompiler compiler(spirv_binary);
+static hpxc::SpecializationConstantType get_specialization_constant_type(
+    const spirv_cross::SPIRType& type) {
+  switch (type.basetype) {
+    case spirv_cross::SPIRType::Boolean:
+      return hpxc::SpecializationConstantType::Bool;
+    case spirv_cross::SPIRType::Int:
+      return hpxc::SpecializationConstantType::Int;
+    case spirv_cross::SPIRType::UInt:
+      return hpxc::SpecializationConstantType::UInt;
+    case spirv_cross::SPIRType::Float:
+      return hpxc::SpecializationConstantType::Float;
+    default:
+      return hpxc::SpecializationConstantType::Unknown;
+  }
+}
 
-    m_entryPointName = compiler.getEntryPointName();
-    m_descriptorInfoMap = compiler.getDescriptorInfos();
-    m_pushConstantRangeMap = compiler.getPushConstantRanges();
+std::unordered_map<std::string, hpxc::SpecializationConstantInfo>
+ShaderCompiler::getSpecializationConstants() const {
+  std::unordered_map<std::string, hpxc::SpecializationConstantInfo>
+      specialization_constant_map;
+
+  for (const auto& constant : this->get_specialization_constants()) {
+    const auto& type = this->get_type(
+        this->get<spirv_cross::SPIRConstant>(constant.id).constant_type);
+
+    hpxc::SpecializationConstantInfo specialization_constant_info;
+    specialization_constant_info.constant_id = constant.constant_id;
+    // bool is VkBool32 on the api side
+    specialization_constant_info.size =
+        type.basetype == spirv_cross::SPIRType::Boolean
+            ? static_cast<uint32_t>(sizeof(VkBool32))
+            : type.width / 8U;
+    specialization_constant_info.type = get_specialization_constant_type(type);
+
+    auto name = this->get_name(constant.id);
+    if (name.empty()) {
+      name = std::to_string(constant.constant_id);
+    }
+
+    specialization_constant_map.insert({name, specialization_constant_info});
   }
 
-  {
-    vk::ShaderModuleCreateInfo shader_module_info{};
-    shader_module_info.codeSize = spirv_binary.size() * sizeof(uint32_t);
-    shader_module_info.pCode = spirv_binary.data();
+  return specialization_constant_map;
+}
+
+hpxc::ShaderReflection ShaderCompiler::getReflection() const {
+  hpxc::ShaderReflection reflection;
 
-    m_ptrShaderModule =
-        ptr_context->getDevice()->getLogicalDevice()->createShaderModuleUnique(
-            shader_module_info);
+  const auto resources = this->get_shader_resources();
+
+  reflection.entry_point_name = getEntryPointName();
+  reflection.stage_flags = getShaderStageFlags();
+  reflection.descriptor_info_map =
+      getDescriptorInfos(resources, reflection.stage_flags);
+  reflection.push_constant_range_map =
+      getPushConstantRanges(resources, reflection.stage_flags);
+  reflection.specialization_constant_map = getSpecializationConstants();
+
+  return reflection;
+}
+
+static uint64_t hash_spirv_binary(const std::vector<uint32_t>& spirv_binary) {
+  // FNV-1a per word
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (const auto word : spirv_binary) {
+    hash ^= word;
+    hash *= 0x100000001b3ULL;
   }
+
+  return hash;
+}
+
+hpxc::ShaderReflection hpxc::gpu::ShaderModule::reflect(
+    const std::vector<uint32_t>& spirv_binary) {
+  const ShaderCompiler compiler(spirv_binary);
+
+  return compiler.getReflection();
+}
+
+hpxc::gpu::ShaderModule::ShaderModule(
+    const std::unique_ptr<Context>& ptr_context,
+    const std::vector<uint32_t>& spirv_binary)
+    : ShaderModule(ptr_context, spirv_binary, reflect(spirv_binary)) {}
+
+hpxc::gpu::ShaderModule::ShaderModule(
+    const std::unique_ptr<Context>& ptr_context,
+    const std::vector<uint32_t>& spirv_binary,
+    const ShaderReflection& reflection)
+    : m_reflection(reflection),
+      m_spirvHash(hash_spirv_binary(spirv_binary)) {
+  vk::ShaderModuleCreateInfo shader_module_info{};
+  shader_module_info.codeSize = spirv_binary.size() * sizeof(uint32_t);
+  shader_module_info.pCode = spirv_binary.data();
+
+  m_ptrShaderModule =
+      ptr_context->getDevice()->getLogicalDevice()->createShaderModuleUnique(
+          shader_module_info);
 }
 
 hpxc::gpu::ShaderModule::~ShaderModule() {}
@@ -0,0 +1,89 @@
+#include <cstring>
+#include <format>
+
+#include "../gpu.hpp"
+
+static VkBool32 to_vk_bool(const bool value) {
+  return value ? VK_TRUE : VK_FALSE;
+}
+
+static hpxc::SpecializationConstantType get_value_type(
+    const hpxc::SpecializationValue& value) {
+  return std::visit(
+      [](const auto& alternative) {
+        using T = std::decay_t<decltype(alternative)>;
+        if constexpr (std::is_same_v<T, bool>) {
+          return hpxc::SpecializationConstantType::Bool;
+        } else if constexpr (std::is_same_v<T, int32_t>) {
+          return hpxc::SpecializationConstantType::Int;
+        } else if constexpr (std::is_same_v<T, uint32_t>) {
+          return hpxc::SpecializationConstantType::UInt;
+        } else {
+          return hpxc::SpecializationConstantType::Float;
+        }
+      },
+      value);
+}
+
+hpxc::gpu::Specialization::Specialization(
+    const ShaderModule& shader_module,
+    const SpecializationValueMap& specialization_values) {
+  const auto& specialization_constant_map =
+      shader_module.getSpecializationConstantMap();
+
+  m_mapEntries.reserve(specialization_values.size());
+  m_data.reserve(specialization_values.size() * sizeof(uint32_t));
+
+  for (const auto& [name, value] : specialization_values) {
+    const auto constant_itr = specialization_constant_map.find(name);
+    if (constant_itr == specialization_constant_map.end()) {
+      throw std::runtime_error(
+          std::format("Unknown specialization constant: {}", name));
+    }
+
+    const auto& specialization_constant_info = constant_itr->second;
+    if (specialization_constant_info.size != sizeof(uint32_t)) {
+      throw std::runtime_error(std::format(
+          "Unsupported specialization constant size: {} ({} bytes)", name,
+          specialization_constant_info.size));
+    }
+    // bits are copied as they are, so the type must be the same as shader
+    if (get_value_type(value) != specialization_constant_info.type) {
+      throw std::runtime_error(std::format(
+          "Specialization constant type mismatch: {} (bool, int, uint and "
+          "float must match the shader declaration)",
+          name));
+    }
+
+    uint32_t raw_value = 0U;
+    std::visit(
+        [&raw_value](const auto& alternative) {
+          using T = std::decay_t<decltype(alternative)>;
+          if constexpr (std::is_same_v<T, bool>) {
+            raw_value = to_vk_bool(alternative);
+          } else {
+            std::memcpy(&raw_value, &alternative, sizeof(uint32_t));
+          }
+        },
+        value);
+
+    const auto offset = static_cast<uint32_t>(m_data.size());
+    m_data.resize(m_data.size() + sizeof(uint32_t));
+    std::memcpy(m_data.data() + offset, &raw_value, sizeof(uint32_t));
+
+    m_mapEntries.emplace_back(specialization_constant_info.constant_id, offset,
+                              sizeof(uint32_t));
+  }
+}
+
+hpxc::gpu::Specialization::~Specialization() {}
+
+vk::SpecializationInfo hpxc::gpu::Specialization::getSpecializationInfo()
+    const {
+  vk::SpecializationInfo specialization_info;
+  specialization_info.setMapEntries(m_mapEntries);
+  specialization_info.setDataSize(m_data.size());
+  specialization_info.setPData(m_data.data());
+
+  return specialization_info;
+}
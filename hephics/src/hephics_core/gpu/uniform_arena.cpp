@@ -0,0 +1,45 @@
+#include <algorithm>
+#include <format>
+
+#include "../gpu.hpp"
+
+hpxc::gpu::UniformArena::UniformArena(
+    const std::unique_ptr<Context>& ptr_context, const size_t size,
+    const BufferUsage buffer_usage) {
+  if (buffer_usage != BufferUsage::UniformBuffer &&
+      buffer_usage != BufferUsage::StorageBuffer) {
+    throw std::runtime_error(
+        "uniform arena usage must be uniform or storage buffer.");
+  }
+
+  const auto& limits =
+      ptr_context->getDevice()->getPhysicalDevice().getProperties().limits;
+  m_alignment = buffer_usage == BufferUsage::UniformBuffer
+                    ? limits.minUniformBufferOffsetAlignment
+                    : limits.minStorageBufferOffsetAlignment;
+  m_alignment = std::max(m_alignment, vk::DeviceSize{1U});
+
+  // host coherent memory, so that no flush is needed after writing
+  m_ptrBuffer =
+      std::make_unique<Buffer>(ptr_context, MemoryUsage::CpuOnly,
+                               TransferType::TransferDst,
+                               std::vector<BufferUsage>{buffer_usage}, size);
+  // kept mapped, freeing memory unmaps it implicitly
+  m_ptrMappedMemory =
+      static_cast<std::byte*>(m_ptrBuffer->mapMemory(ptr_context));
+}
+
+hpxc::gpu::UniformArena::~UniformArena() {}
+
+uint32_t hpxc::gpu::UniformArena::allocate(const size_t size) {
+  // alignment is power of two
+  const auto offset = (m_offset + m_alignment - 1U) & ~(m_alignment - 1U);
+  if (offset + size > m_ptrBuffer->getSize()) {
+    throw std::runtime_error(std::format(
+        "uniform arena is full (used {} of {} bytes).", m_offset,
+        m_ptrBuffer->getSize()));
+  }
+  m_offset = offset + size;
+
+  return static_cast<uint32_t>(offset);
+}
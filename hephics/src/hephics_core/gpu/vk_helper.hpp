@@ -21,6 +21,12 @@ vk::ImageLayout getImageLayout(const hpxc::ImageLayout image_layout);
 
 vk::Format getImageFormat(const hpxc::ImageFormat image_format);
 
+vk::FormatFeatureFlags getFormatFeatureFlags(
+    const hpxc::FormatFeature format_feature);
+
+// byte size of one texel (0: format isn't any of hpxc::ImageFormat)
+uint32_t getTexelSize(const vk::Format format);
+
 vk::ImageAspectFlags getImageAspectFlags(const hpxc::ImageAspect image_aspect);
 
 vk::ShaderStageFlags getShaderStageFlagBits(
@@ -205,11 +205,145 @@ vk::Format vk_helper::getImageFormat(const hpxc::ImageFormat image_format) {
       return vk::Format::eR8G8B8A8Sint;
     case ImageFormat::R8G8B8A8Srgb:
       return vk::Format::eR8G8B8A8Srgb;
+    case ImageFormat::R16Unorm:
+      return vk::Format::eR16Unorm;
+    case ImageFormat::R16Uint:
+      return vk::Format::eR16Uint;
+    case ImageFormat::R16Sint:
+      return vk::Format::eR16Sint;
+    case ImageFormat::R16Sfloat:
+      return vk::Format::eR16Sfloat;
+    case ImageFormat::R16G16Unorm:
+      return vk::Format::eR16G16Unorm;
+    case ImageFormat::R16G16Uint:
+      return vk::Format::eR16G16Uint;
+    case ImageFormat::R16G16Sfloat:
+      return vk::Format::eR16G16Sfloat;
+    case ImageFormat::R16G16B16A16Unorm:
+      return vk::Format::eR16G16B16A16Unorm;
+    case ImageFormat::R16G16B16A16Uint:
+      return vk::Format::eR16G16B16A16Uint;
+    case ImageFormat::R16G16B16A16Sint:
+      return vk::Format::eR16G16B16A16Sint;
+    case ImageFormat::R16G16B16A16Sfloat:
+      return vk::Format::eR16G16B16A16Sfloat;
+    case ImageFormat::R32Uint:
+      return vk::Format::eR32Uint;
+    case ImageFormat::R32Sint:
+      return vk::Format::eR32Sint;
+    case ImageFormat::R32Sfloat:
+      return vk::Format::eR32Sfloat;
+    case ImageFormat::R32G32Uint:
+      return vk::Format::eR32G32Uint;
+    case ImageFormat::R32G32Sfloat:
+      return vk::Format::eR32G32Sfloat;
+    case ImageFormat::R32G32B32A32Uint:
+      return vk::Format::eR32G32B32A32Uint;
+    case ImageFormat::R32G32B32A32Sint:
+      return vk::Format::eR32G32B32A32Sint;
+    case ImageFormat::R32G32B32A32Sfloat:
+      return vk::Format::eR32G32B32A32Sfloat;
+    case ImageFormat::A2B10G10R10Unorm:
+      return vk::Format::eA2B10G10R10UnormPack32;
+    case ImageFormat::B10G11R11Ufloat:
+      return vk::Format::eB10G11R11UfloatPack32;
     default:
       return vk::Format::eR8G8B8A8Unorm;
   }
 }
 
+vk::FormatFeatureFlags vk_helper::getFormatFeatureFlags(
+    const hpxc::FormatFeature format_feature) {
+  using FormatFeature = hpxc::FormatFeature;
+
+  switch (format_feature) {
+    case FormatFeature::Sampled:
+      return vk::FormatFeatureFlagBits::eSampledImage;
+    case FormatFeature::SampledLinearFilter:
+      return vk::FormatFeatureFlagBits::eSampledImage |
+             vk::FormatFeatureFlagBits::eSampledImageFilterLinear;
+    case FormatFeature::Storage:
+      return vk::FormatFeatureFlagBits::eStorageImage;
+    case FormatFeature::StorageAtomic:
+      return vk::FormatFeatureFlagBits::eStorageImage |
+             vk::FormatFeatureFlagBits::eStorageImageAtomic;
+    case FormatFeature::ColorAttachment:
+      return vk::FormatFeatureFlagBits::eColorAttachment;
+    case FormatFeature::BlitSrc:
+      return vk::FormatFeatureFlagBits::eBlitSrc;
+    case FormatFeature::BlitDst:
+      return vk::FormatFeatureFlagBits::eBlitDst;
+    case FormatFeature::TransferSrc:
+      return vk::FormatFeatureFlagBits::eTransferSrc;
+    case FormatFeature::TransferDst:
+      return vk::FormatFeatureFlagBits::eTransferDst;
+    default:
+      return vk::FormatFeatureFlags{};
+  }
+}
+
+uint32_t vk_helper::getTexelSize(const vk::Format format) {
+  switch (format) {
+    case vk::Format::eR8Unorm:
+    case vk::Format::eR8Snorm:
+    case vk::Format::eR8Uscaled:
+    case vk::Format::eR8Sscaled:
+    case vk::Format::eR8Uint:
+    case vk::Format::eR8Sint:
+    case vk::Format::eR8Srgb:
+      return 1U;
+    case vk::Format::eR8G8Unorm:
+    case vk::Format::eR8G8Snorm:
+    case vk::Format::eR8G8Uscaled:
+    case vk::Format::eR8G8Sscaled:
+    case vk::Format::eR8G8Uint:
+    case vk::Format::eR8G8Sint:
+    case vk::Format::eR8G8Srgb:
+    case vk::Format::eR16Unorm:
+    case vk::Format::eR16Uint:
+    case vk::Format::eR16Sint:
+    case vk::Format::eR16Sfloat:
+      return 2U;
+    case vk::Format::eR8G8B8Unorm:
+    case vk::Format::eR8G8B8Snorm:
+    case vk::Format::eR8G8B8Uscaled:
+    case vk::Format::eR8G8B8Sscaled:
+    case vk::Format::eR8G8B8Uint:
+    case vk::Format::eR8G8B8Sint:
+    case vk::Format::eR8G8B8Srgb:
+      return 3U;
+    case vk::Format::eR8G8B8A8Unorm:
+    case vk::Format::eR8G8B8A8Snorm:
+    case vk::Format::eR8G8B8A8Uscaled:
+    case vk::Format::eR8G8B8A8Sscaled:
+    case vk::Format::eR8G8B8A8Uint:
+    case vk::Format::eR8G8B8A8Sint:
+    case vk::Format::eR8G8B8A8Srgb:
+    case vk::Format::eR16G16Unorm:
+    case vk::Format::eR16G16Uint:
+    case vk::Format::eR16G16Sfloat:
+    case vk::Format::eR32Uint:
+    case vk::Format::eR32Sint:
+    case vk::Format::eR32Sfloat:
+    case vk::Format::eA2B10G10R10UnormPack32:
+    case vk::Format::eB10G11R11UfloatPack32:
+      return 4U;
+    case vk::Format::eR16G16B16A16Unorm:
+    case vk::Format::eR16G16B16A16Uint:
+    case vk::Format::eR16G16B16A16Sint:
+    case vk::Format::eR16G16B16A16Sfloat:
+    case vk::Format::eR32G32Uint:
+    case vk::Format::eR32G32Sfloat:
+      return 8U;
+    case vk::Format::eR32G32B32A32Uint:
+    case vk::Format::eR32G32B32A32Sint:
+    case vk::Format::eR32G32B32A32Sfloat:
+      return 16U;
+    default:
+      return 0U;
+  }
+}
+
 vk::ImageAspectFlags vk_helper::getImageAspectFlags(
     const hpxc::ImageAspect image_aspect) {
   using ImageAspect = hpxc::ImageAspect;
@@ -6,6 +6,13 @@ This header file is used to manage the asset file input/output.
 
 #pragma once
 
+#include <future>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "gpu.hpp"
+
 namespace hpxc {
 
 namespace io {
@@ -15,12 +22,52 @@ namespace io {
 /// </summary>
 namespace shader {
 
+/// <summary>
+/// spirv-opt (SPIRV-Tools) pass set applied after glslang compile.
+/// </summary>
+enum class Optimization {
+  None,
+  // spirv-opt -O
+  Performance,
+  // spirv-opt -Os
+  Size,
+  // remove debug instructions, including names.
+  // names are used by hpxc::gpu::ShaderModule::reflect,
+  //   so reflect an unstripped binary and pass the result to
+  //   hpxc::gpu::ShaderModule(ptr_context, spirv_binary, reflection)
+  //   (readModule does so).
+  StripDebugInfo,
+};
+
+/// <summary>
+/// Set directory of compiled spirv-binary cache (default: "shaders/cache").
+/// Cache entries are addressed by a hash of
+///   shader source with its included files, shader stage,
+///   target spirv version and glslang version.
+/// Empty path disables the cache.
+/// </summary>
+/// <param name="directory_path"></param>
+void setCacheDirectory(const std::string& directory_path);
+
+/// <summary>
+/// Get the shader file and all files it includes (recursively),
+///   which are the sources hashed into the compile cache key.
+/// </summary>
+/// <param name="file_path">same as read function's file_path</param>
+/// <returns>file_path first, then included file paths</returns>
+std::vector<std::string> getSourcePaths(const std::string& file_path);
+
 /// <summary>
 /// Read shader code from glsl file (ex> .vert, .frag, etc...)
+/// If the compile cache has the same shader, glslang compile is skipped.
+/// Optimized binary is cached separately per optimization level.
 /// </summary>
 /// <param name="file_path"></param>
+/// <param name="optimization">spirv-opt level</param>
 /// <returns>spirv-binary</returns>
-std::vector<uint32_t> readText(const std::string& file_path);
+std::vector<uint32_t> readText(
+    const std::string& file_path,
+    const Optimization optimization = Optimization::None);
 
 /// <summary>
 /// Read spirv-binary from shader binary file (.spv).
@@ -35,8 +82,46 @@ std::vector<uint32_t> readBinary(const std::string& file_path);
 /// <param name="file_path">path's extension
 ///   .spv, .vert, .frag, etc...
 /// </param>
+/// <param name="optimization">
+///   spirv-opt level (only for glsl file, .spv is read as it is)
+/// </param>
 /// <returns>spirv-binary</returns>
-std::vector<uint32_t> read(const std::string& file_path);
+std::vector<uint32_t> read(
+    const std::string& file_path,
+    const Optimization optimization = Optimization::None);
+
+/// <summary>
+/// Read shader and create its module without spirv-cross if possible.
+/// Reflection is serialized next to the spirv-binary
+///   (.spv file itself, or the compile cache entry for glsl file),
+///   and spirv-cross runs only when the reflection file is missing or stale.
+/// </summary>
+/// <param name="ptr_context"></param>
+/// <param name="file_path">same as read function's file_path</param>
+/// <param name="optimization">spirv-opt level</param>
+/// <returns>shader module</returns>
+gpu::ShaderModule readModule(
+    const std::unique_ptr<gpu::Context>& ptr_context,
+    const std::string& file_path,
+    const Optimization optimization = Optimization::None);
+
+/// <summary>
+/// Read many shaders in parallel.
+/// glslang is initialized only once,
+///   and each shader is compiled on a std::async thread.
+/// Compile errors are delivered as exceptions through each future.
+/// Destroying a future waits for its compile.
+/// </summary>
+/// <param name="file_paths">same as read function's file_path</param>
+/// <param name="thread_count">
+///   count of shaders compiled at once (0: hardware concurrency)
+/// </param>
+/// <param name="optimization">spirv-opt level</param>
+/// <returns>spirv-binary futures in the same order as file_paths</returns>
+std::vector<std::future<std::vector<uint32_t>>> readMany(
+    const std::vector<std::string>& file_paths,
+    const uint32_t thread_count = 0U,
+    const Optimization optimization = Optimization::None);
 
 /// <summary>
 /// Write shader binary.
@@ -46,6 +131,37 @@ std::vector<uint32_t> read(const std::string& file_path);
 void write(const std::string& file_path,
            const std::vector<uint32_t>& shader_binary);
 
+/// <summary>
+/// Get reflection file path placed next to the shader binary file.
+///   ex> shaders/compute/sample.spv -> shaders/compute/sample.refl
+/// </summary>
+/// <param name="file_path">shader binary file path</param>
+/// <returns>reflection file path</returns>
+std::string getReflectionPath(const std::string& file_path);
+
+/// <summary>
+/// Write shader reflection as a compact binary blob.
+/// The blob records a hash of the spirv-binary it was made from.
+/// </summary>
+/// <param name="file_path">output file path</param>
+/// <param name="shader_binary">spirv-binary reflected</param>
+/// <param name="reflection">hpxc::gpu::ShaderModule::reflect result</param>
+void writeReflection(const std::string& file_path,
+                     const std::vector<uint32_t>& shader_binary,
+                     const ShaderReflection& reflection);
+
+/// <summary>
+/// Read shader reflection written by writeReflection.
+/// </summary>
+/// <param name="file_path">reflection file path</param>
+/// <param name="shader_binary">spirv-binary which the reflection is for</param>
+/// <returns>
+///   reflection, or std::nullopt if the file is missing, broken,
+///   of an old format, or made from another spirv-binary
+/// </returns>
+std::optional<ShaderReflection> readReflection(
+    const std::string& file_path, const std::vector<uint32_t>& shader_binary);
+
 }  // namespace shader
 
 }  // namespace io
@@ -1,14 +1,41 @@
 #include <glslang/Public/ShaderLang.h>
 #include <glslang/SPIRV/GlslangToSpv.h>
 
+#include <spirv-tools/libspirv.h>
+#include <spirv-tools/optimizer.hpp>
+
+#include <algorithm>
+#include <filesystem>
 #include <format>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <optional>
+#include <regex>
+#include <semaphore>
+#include <set>
+#include <shared_mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 
 #include "../io.hpp"
 
+constexpr auto TARGET_SPIRV_VERSION =
+    glslang::EShTargetLanguageVersion::EShTargetSpv_1_5;
+// spirv 1.5 is the version of vulkan 1.2
+constexpr auto TARGET_SPIRV_ENVIRONMENT = SPV_ENV_VULKAN_1_2;
+constexpr uint32_t SPIRV_MAGIC_NUMBER = 0x07230203U;
+
+// "HPXR": hephics reflection
+constexpr uint32_t REFLECTION_MAGIC_NUMBER = 0x52585048U;
+// increment whenever hpxc::ShaderReflection layout is changed
+constexpr uint32_t REFLECTION_FORMAT_VERSION = 6U;
+
+static std::shared_mutex g_cache_mutex;
+static std::string g_cache_directory = "shaders/cache";
+
 static std::pair<std::string, ::EShLanguage> translate_shader_stage(
     const std::string& shader_code_path) {
   if (shader_code_path.ends_with(".vert")) {
@@ -139,21 +166,244 @@ static TBuiltInResource init_t_built_in_resources() {
   return resources;
 }
 
+static std::string read_text_file(const std::filesystem::path& file_path) {
+  std::stringstream text;
+  std::ifstream input_file(file_path);
+  text << input_file.rdbuf();
+  input_file.close();
+
+  return text.str();
+}
+
+/// <summary>
+/// Resolve '#include' directives (GL_GOOGLE_include_directive)
+///   relative to the including file's directory.
+/// </summary>
+class FileIncluder : public glslang::TShader::Includer {
+ public:
+  IncludeResult* includeLocal(const char* header_name,
+                              const char* includer_name,
+                              size_t inclusion_depth) override {
+    static_cast<void>(inclusion_depth);
+
+    const auto header_path =
+        std::filesystem::path(includer_name).parent_path() / header_name;
+    if (!std::filesystem::exists(header_path)) {
+      return nullptr;
+    }
+
+    auto ptr_content = new std::string(read_text_file(header_path));
+
+    return new IncludeResult(header_path.generic_string(), ptr_content->data(),
+                             ptr_content->size(), ptr_content);
+  }
+
+  IncludeResult* includeSystem(const char* header_name,
+                               const char* includer_name,
+                               size_t inclusion_depth) override {
+    return includeLocal(header_name, includer_name, inclusion_depth);
+  }
+
+  void releaseInclude(IncludeResult* result) override {
+    if (result) {
+      delete static_cast<std::string*>(result->userData);
+      delete result;
+    }
+  }
+};
+
+/// <summary>
+/// Collect the shader source and all files it includes (recursively).
+/// The result is the content addressed by the compile cache,
+///   so editing an included file changes the cache key.
+/// </summary>
+static void collect_shader_sources(const std::filesystem::path& file_path,
+                                   const std::string& shader_code,
+                                   std::set<std::string>& visited_paths,
+                                   std::string& sources) {
+  static const std::regex include_regex(
+      R"(^\s*#\s*include\s*[<"]([^>"]+)[>"])");
+
+  sources += file_path.generic_string();
+  sources += '\n';
+  sources += shader_code;
+  sources += '\n';
+
+  std::istringstream lines(shader_code);
+  std::string line;
+  std::smatch match;
+  while (std::getline(lines, line)) {
+    if (!std::regex_search(line, match, include_regex)) {
+      continue;
+    }
+
+    const auto header_path = file_path.parent_path() / match[1].str();
+    const auto header_key = header_path.lexically_normal().generic_string();
+    if (visited_paths.contains(header_key) ||
+        !std::filesystem::exists(header_path)) {
+      continue;
+    }
+    visited_paths.insert(header_key);
+
+    collect_shader_sources(header_path, read_text_file(header_path),
+                           visited_paths, sources);
+  }
+}
+
+static uint64_t hash_fnv1a(const void* data, const size_t size) {
+  const auto bytes = reinterpret_cast<const uint8_t*>(data);
+
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (size_t idx = 0U; idx < size; idx += 1U) {
+    hash ^= bytes[idx];
+    hash *= 0x100000001b3ULL;
+  }
+
+  return hash;
+}
+
+static uint64_t hash_fnv1a(const std::string& data) {
+  return hash_fnv1a(data.data(), data.size());
+}
+
+static std::filesystem::path get_cache_path(
+    const std::string& file_path, const std::string& shader_type,
+    const std::string& shader_code,
+    const hpxc::io::shader::Optimization optimization) {
+  std::string cache_directory;
+  {
+    std::shared_lock lock(g_cache_mutex);
+    cache_directory = g_cache_directory;
+  }
+  if (cache_directory.empty()) {
+    return {};
+  }
+
+  const auto glslang_version = glslang::GetVersion();
+  std::string key = std::format(
+      "stage:{}|spirv:{}|glslang:{}.{}.{}{}|opt:{}|spirv-tools:{}\n",
+      shader_type, static_cast<int32_t>(TARGET_SPIRV_VERSION),
+      glslang_version.major, glslang_version.minor, glslang_version.patch,
+      glslang_version.flavor, static_cast<int32_t>(optimization),
+      spvSoftwareVersionString());
+
+  std::set<std::string> visited_paths;
+  collect_shader_sources(file_path, shader_code, visited_paths, key);
+
+  return std::filesystem::path(cache_directory) /
+         std::format("{:016x}.spv", hash_fnv1a(key));
+}
+
+static std::optional<std::vector<uint32_t>> load_cache(
+    const std::filesystem::path& cache_path) {
+  std::error_code error_code;
+  if (cache_path.empty() ||
+      !std::filesystem::is_regular_file(cache_path, error_code)) {
+    return std::nullopt;
+  }
+
+  std::ifstream file(cache_path, std::ios::ate | std::ios::binary);
+  if (!file.is_open()) {
+    return std::nullopt;
+  }
+
+  const auto file_size = static_cast<size_t>(file.tellg());
+  if (file_size == 0U || file_size % sizeof(uint32_t) != 0U) {
+    return std::nullopt;
+  }
+
+  std::vector<uint32_t> shader_binary(file_size / sizeof(uint32_t));
+  file.seekg(0);
+  file.read(reinterpret_cast<char*>(shader_binary.data()), file_size);
+
+  // a truncated or foreign file is treated as a cache miss
+  if (!file || shader_binary.front() != SPIRV_MAGIC_NUMBER) {
+    return std::nullopt;
+  }
+
+  return shader_binary;
+}
+
+/// <summary>
+/// Write to a temporary file, then rename,
+///   so that readers never observe a partially written file.
+/// </summary>
+static void write_file_atomically(
+    const std::filesystem::path& file_path,
+    const std::function<void(std::ofstream&)>& write_content) {
+  auto temporary_path = file_path;
+  temporary_path += std::format(
+      ".{}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+  std::error_code error_code;
+  {
+    std::ofstream output_file(temporary_path, std::ios::binary);
+    write_content(output_file);
+    if (!output_file) {
+      output_file.close();
+      std::filesystem::remove(temporary_path, error_code);
+      return;
+    }
+  }
+
+  std::filesystem::rename(temporary_path, file_path, error_code);
+  if (error_code) {
+    std::filesystem::remove(temporary_path, error_code);
+  }
+}
+
+static void store_cache(const std::filesystem::path& cache_path,
+                        const std::vector<uint32_t>& shader_binary) {
+  if (cache_path.empty()) {
+    return;
+  }
+
+  std::error_code error_code;
+  std::filesystem::create_directories(cache_path.parent_path(), error_code);
+  if (error_code) {
+    return;
+  }
+
+  write_file_atomically(cache_path, [&shader_binary](std::ofstream& file) {
+    file.write(reinterpret_cast<const char*>(shader_binary.data()),
+               shader_binary.size() * sizeof(uint32_t));
+  });
+}
+
+/// <summary>
+/// glslang requires process-wide initialization before any compile.
+/// It is done only once, and finalized at program exit.
+/// </summary>
+class GlslangProcess {
+ public:
+  GlslangProcess() { glslang::InitializeProcess(); }
+  ~GlslangProcess() { glslang::FinalizeProcess(); }
+};
+
+static void initialize_glslang_process() {
+  // thread-safe: function local static is initialized only once
+  static GlslangProcess s_glslang_process;
+}
+
 static std::vector<uint32_t> compile_shader(const ::EShLanguage& shader_stage,
+                                            const std::string& file_path,
                                             const std::string& shader_code) {
-  glslang::InitializeProcess();
+  initialize_glslang_process();
 
   std::vector shader_c_strings = {shader_code.data()};
+  std::vector shader_names = {file_path.data()};
 
   glslang::TShader shader(shader_stage);
   shader.setEnvTarget(glslang::EShTargetLanguage::EShTargetSpv,
-                      glslang::EShTargetLanguageVersion::EShTargetSpv_1_5);
-  shader.setStrings(shader_c_strings.data(),
-                    static_cast<int32_t>(shader_c_strings.size()));
+                      TARGET_SPIRV_VERSION);
+  shader.setStringsWithLengthsAndNames(
+      shader_c_strings.data(), nullptr, shader_names.data(),
+      static_cast<int32_t>(shader_c_strings.size()));
 
   EShMessages messages = (EShMessages)(EShMsgSpvRules | EShMsgVulkanRules);
   const auto t_built_in_resources = init_t_built_in_resources();
-  if (!shader.parse(&t_built_in_resources, 100, false, messages)) {
+  FileIncluder includer;
+  if (!shader.parse(&t_built_in_resources, 100, false, messages, includer)) {
     throw std::runtime_error(shader_code + "\n" + shader.getInfoLog());
   }
 
@@ -166,20 +416,112 @@ static std::vector<uint32_t> compile_shader(const ::EShLanguage& shader_stage,
 
   std::vector<uint32_t> shader_binary;
   glslang::GlslangToSpv(*program.getIntermediate(shader_stage), shader_binary);
-  glslang::FinalizeProcess();
 
   return shader_binary;
 }
 
-std::vector<uint32_t> hpxc::io::shader::readText(const std::string& file_path) {
+static std::vector<uint32_t> optimize_shader(
+    const std::string& file_path, const std::vector<uint32_t>& shader_binary,
+    const hpxc::io::shader::Optimization optimization) {
+  using hpxc::io::shader::Optimization;
+
+  spvtools::Optimizer optimizer(TARGET_SPIRV_ENVIRONMENT);
+  switch (optimization) {
+    case Optimization::Performance:
+      optimizer.RegisterPerformancePasses();
+      break;
+    case Optimization::Size:
+      optimizer.RegisterSizePasses();
+      break;
+    case Optimization::StripDebugInfo:
+      optimizer.RegisterPass(spvtools::CreateStripDebugInfoPass());
+      break;
+    default:
+      return shader_binary;
+  }
+
+  std::string messages;
+  optimizer.SetMessageConsumer(
+      [&messages](spv_message_level_t level, const char* source,
+                  const spv_position_t& position, const char* message) {
+        static_cast<void>(source);
+        if (level > SPV_MSG_WARNING) {
+          return;
+        }
+        messages += std::format("{}: {}\n", position.index, message);
+      });
+
+  std::vector<uint32_t> optimized_binary;
+  if (!optimizer.Run(shader_binary.data(), shader_binary.size(),
+                     &optimized_binary)) {
+    throw std::runtime_error(
+        std::format("Failed to optimize shader: {}\n{}", file_path, messages));
+  }
+
+  return optimized_binary;
+}
+
+void hpxc::io::shader::setCacheDirectory(const std::string& directory_path) {
+  std::unique_lock lock(g_cache_mutex);
+  g_cache_directory = directory_path;
+}
+
+std::vector<std::string> hpxc::io::shader::getSourcePaths(
+    const std::string& file_path) {
+  std::vector<std::string> source_paths = {file_path};
+  if (file_path.ends_with(".spv")) {
+    return source_paths;
+  }
+
+  std::set<std::string> visited_paths;
+  std::string sources;
+  collect_shader_sources(file_path, read_text_file(file_path), visited_paths,
+                         sources);
+  source_paths.insert(source_paths.end(), visited_paths.begin(),
+                      visited_paths.end());
+
+  return source_paths;
+}
+
+/// <summary>
+/// Same as readText, and give the compile cache entry path
+///   (empty if the cache is disabled).
+/// </summary>
+static std::vector<uint32_t> read_text(
+    const std::string& file_path,
+    const hpxc::io::shader::Optimization optimization,
+    std::filesystem::path& cache_path) {
+  using hpxc::io::shader::Optimization;
+
   const auto& [shader_type, stage] = translate_shader_stage(file_path);
 
-  std::stringstream shader_code;
-  std::ifstream input_file(file_path);
-  shader_code << input_file.rdbuf();
-  input_file.close();
+  const auto shader_code = read_text_file(file_path);
+
+  cache_path =
+      get_cache_path(file_path, shader_type, shader_code, optimization);
+  if (auto cached_binary = load_cache(cache_path)) {
+    return std::move(cached_binary.value());
+  }
 
-  return compile_shader(stage, shader_code.str());
+  // optimized binary is made from the cached unoptimized one,
+  //   so glslang compile is not repeated per optimization level
+  auto shader_binary =
+      optimization == Optimization::None
+          ? compile_shader(stage, file_path, shader_code)
+          : optimize_shader(file_path,
+                            hpxc::io::shader::readText(file_path,
+                                                       Optimization::None),
+                            optimization);
+  store_cache(cache_path, shader_binary);
+
+  return shader_binary;
+}
+
+std::vector<uint32_t> hpxc::io::shader::readText(
+    const std::string& file_path, const Optimization optimization) {
+  std::filesystem::path cache_path;
+
+  return read_text(file_path, optimization, cache_path);
 }
 
 std::vector<uint32_t> hpxc::io::shader::readBinary(
@@ -201,14 +543,89 @@ std::vector<uint32_t> hpxc::io::shader::readBinary(
   return shader_binary;
 }
 
-std::vector<uint32_t> hpxc::io::shader::read(const std::string& file_path) {
+std::vector<uint32_t> hpxc::io::shader::read(const std::string& file_path,
+                                             const Optimization optimization) {
   if (file_path.ends_with(".spv")) {
     return readBinary(file_path);
   } else {
-    return readText(file_path);
+    return readText(file_path, optimization);
   }
 }
 
+hpxc::gpu::ShaderModule hpxc::io::shader::readModule(
+    const std::unique_ptr<gpu::Context>& ptr_context,
+    const std::string& file_path, const Optimization optimization) {
+  const auto is_binary_file = file_path.ends_with(".spv");
+
+  std::filesystem::path binary_path = file_path;
+  const auto shader_binary =
+      is_binary_file ? readBinary(file_path)
+                     : read_text(file_path, optimization, binary_path);
+
+  // no reflection file is kept when the compile cache is disabled
+  const auto reflection_path =
+      binary_path.empty() ? std::string()
+                          : getReflectionPath(binary_path.generic_string());
+  if (!reflection_path.empty()) {
+    const auto reflection = readReflection(reflection_path, shader_binary);
+    if (reflection.has_value()) {
+      return gpu::ShaderModule(ptr_context, shader_binary, reflection.value());
+    }
+  }
+
+  // names are needed by reflection, so stripped binary is not reflected
+  const auto reflection =
+      !is_binary_file && optimization == Optimization::StripDebugInfo
+          ? gpu::ShaderModule::reflect(
+                readText(file_path, Optimization::None))
+          : gpu::ShaderModule::reflect(shader_binary);
+  if (!reflection_path.empty()) {
+    writeReflection(reflection_path, shader_binary, reflection);
+  }
+
+  return gpu::ShaderModule(ptr_context, shader_binary, reflection);
+}
+
+std::vector<std::future<std::vector<uint32_t>>> hpxc::io::shader::readMany(
+    const std::vector<std::string>& file_paths, const uint32_t thread_count,
+    const Optimization optimization) {
+  std::vector<std::future<std::vector<uint32_t>>> results;
+  results.reserve(file_paths.size());
+  if (file_paths.empty()) {
+    return results;
+  }
+
+  // glslang initialization is not thread-safe, so it is done up front
+  initialize_glslang_process();
+
+  const auto worker_count = std::min<size_t>(
+      file_paths.size(),
+      std::max(1U, thread_count != 0U ? thread_count
+                                      : std::thread::hardware_concurrency()));
+
+  // std::async futures join their thread on destruction,
+  //   so no compile outlives the caller and the process-wide statics
+  auto ptr_semaphore = std::make_shared<std::counting_semaphore<>>(
+      static_cast<std::ptrdiff_t>(worker_count));
+  for (const auto& file_path : file_paths) {
+    results.push_back(std::async(
+        std::launch::async, [ptr_semaphore, file_path, optimization]() {
+          ptr_semaphore->acquire();
+          try {
+            auto shader_binary = read(file_path, optimization);
+            ptr_semaphore->release();
+
+            return shader_binary;
+          } catch (...) {
+            ptr_semaphore->release();
+            throw;
+          }
+        }));
+  }
+
+  return results;
+}
+
 void hpxc::io::shader::write(const std::string& file_path,
                              const std::vector<uint32_t>& shader_binary) {
   std::ofstream output_file(file_path, std::ios::binary);
@@ -218,3 +635,194 @@ void hpxc::io::shader::write(const std::string& file_path,
 
   output_file.close();
 }
+
+class ReflectionWriter {
+ private:
+  std::ofstream& m_file;
+
+ public:
+  ReflectionWriter(std::ofstream& file) : m_file(file) {}
+
+  template <typename T>
+  void write(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    m_file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  void write(const std::string& value) {
+    write(static_cast<uint32_t>(value.size()));
+    m_file.write(value.data(), value.size());
+  }
+};
+
+class ReflectionReader {
+ private:
+  std::ifstream& m_file;
+
+ public:
+  ReflectionReader(std::ifstream& file) : m_file(file) {}
+
+  bool isGood() const { return static_cast<bool>(m_file); }
+
+  template <typename T>
+  T read() {
+    static_assert(std::is_trivially_copyable_v<T>);
+    T value{};
+    m_file.read(reinterpret_cast<char*>(&value), sizeof(T));
+
+    return value;
+  }
+
+  std::string readString() {
+    // names longer than this are never written, so the file is broken
+    constexpr uint32_t max_string_size = 1U << 16U;
+
+    const auto size = read<uint32_t>();
+    if (size > max_string_size) {
+      m_file.setstate(std::ios::failbit);
+    }
+    if (!isGood()) {
+      return {};
+    }
+
+    std::string value(size, '\0');
+    m_file.read(value.data(), size);
+
+    return value;
+  }
+};
+
+std::string hpxc::io::shader::getReflectionPath(const std::string& file_path) {
+  return std::filesystem::path(file_path)
+      .replace_extension(".refl")
+      .generic_string();
+}
+
+void hpxc::io::shader::writeReflection(
+    const std::string& file_path, const std::vector<uint32_t>& shader_binary,
+    const ShaderReflection& reflection) {
+  // the reflection file is shared by readers of the same cache entry
+  write_file_atomically(file_path, [&](std::ofstream& output_file) {
+    ReflectionWriter writer(output_file);
+
+    writer.write(REFLECTION_MAGIC_NUMBER);
+    writer.write(REFLECTION_FORMAT_VERSION);
+    writer.write(hash_fnv1a(shader_binary.data(),
+                            shader_binary.size() * sizeof(uint32_t)));
+
+    writer.write(reflection.entry_point_name);
+    writer.write(static_cast<VkShaderStageFlags>(reflection.stage_flags));
+
+    writer.write(static_cast<uint32_t>(reflection.descriptor_info_map.size()));
+    for (const auto& [name, descriptor_info] : reflection.descriptor_info_map) {
+      writer.write(name);
+      writer.write(
+          static_cast<VkShaderStageFlags>(descriptor_info.stage_flags));
+      writer.write(descriptor_info.set);
+      writer.write(descriptor_info.binding);
+      writer.write(static_cast<VkDescriptorType>(descriptor_info.type));
+      writer.write(descriptor_info.size);
+      writer.write(descriptor_info.count);
+      writer.write(static_cast<uint32_t>(descriptor_info.is_runtime_array));
+    }
+
+    writer.write(
+        static_cast<uint32_t>(reflection.push_constant_range_map.size()));
+    for (const auto& [name, push_constant_range] :
+         reflection.push_constant_range_map) {
+      writer.write(name);
+      writer.write(
+          static_cast<VkShaderStageFlags>(push_constant_range.stage_flags));
+      writer.write(push_constant_range.offset);
+      writer.write(static_cast<uint64_t>(push_constant_range.size));
+    }
+
+    writer.write(
+        static_cast<uint32_t>(reflection.specialization_constant_map.size()));
+    for (const auto& [name, specialization_constant_info] :
+         reflection.specialization_constant_map) {
+      writer.write(name);
+      writer.write(specialization_constant_info.constant_id);
+      writer.write(specialization_constant_info.size);
+      writer.write(static_cast<uint32_t>(specialization_constant_info.type));
+    }
+  });
+}
+
+std::optional<hpxc::ShaderReflection> hpxc::io::shader::readReflection(
+    const std::string& file_path, const std::vector<uint32_t>& shader_binary) {
+  std::ifstream input_file(file_path, std::ios::binary);
+  if (!input_file.is_open()) {
+    return std::nullopt;
+  }
+
+  ReflectionReader reader(input_file);
+
+  if (reader.read<uint32_t>() != REFLECTION_MAGIC_NUMBER ||
+      reader.read<uint32_t>() != REFLECTION_FORMAT_VERSION ||
+      reader.read<uint64_t>() !=
+          hash_fnv1a(shader_binary.data(),
+                     shader_binary.size() * sizeof(uint32_t))) {
+    return std::nullopt;
+  }
+
+  ShaderReflection reflection;
+  reflection.entry_point_name = reader.readString();
+  reflection.stage_flags =
+      vk::ShaderStageFlags(reader.read<VkShaderStageFlags>());
+
+  const auto descriptor_count = reader.read<uint32_t>();
+  for (uint32_t idx = 0U; idx < descriptor_count && reader.isGood();
+       idx += 1U) {
+    const auto name = reader.readString();
+
+    DescriptorInfo descriptor_info;
+    descriptor_info.stage_flags =
+        vk::ShaderStageFlags(reader.read<VkShaderStageFlags>());
+    descriptor_info.set = reader.read<uint32_t>();
+    descriptor_info.binding = reader.read<uint32_t>();
+    descriptor_info.type =
+        static_cast<vk::DescriptorType>(reader.read<VkDescriptorType>());
+    descriptor_info.size = reader.read<uint32_t>();
+    descriptor_info.count = reader.read<uint32_t>();
+    descriptor_info.is_runtime_array = reader.read<uint32_t>() != 0U;
+
+    reflection.descriptor_info_map.insert({name, descriptor_info});
+  }
+
+  const auto push_constant_count = reader.read<uint32_t>();
+  for (uint32_t idx = 0U; idx < push_constant_count && reader.isGood();
+       idx += 1U) {
+    const auto name = reader.readString();
+
+    PushConstantRange push_constant_range;
+    push_constant_range.stage_flags =
+        vk::ShaderStageFlags(reader.read<VkShaderStageFlags>());
+    push_constant_range.offset = reader.read<uint32_t>();
+    push_constant_range.size =
+        static_cast<size_t>(reader.read<uint64_t>());
+
+    reflection.push_constant_range_map.insert({name, push_constant_range});
+  }
+
+  const auto specialization_constant_count = reader.read<uint32_t>();
+  for (uint32_t idx = 0U;
+       idx < specialization_constant_count && reader.isGood(); idx += 1U) {
+    const auto name = reader.readString();
+
+    SpecializationConstantInfo specialization_constant_info;
+    specialization_constant_info.constant_id = reader.read<uint32_t>();
+    specialization_constant_info.size = reader.read<uint32_t>();
+    specialization_constant_info.type =
+        static_cast<SpecializationConstantType>(reader.read<uint32_t>());
+
+    reflection.specialization_constant_map.insert(
+        {name, specialization_constant_info});
+  }
+
+  if (!reader.isGood()) {
+    return std::nullopt;
+  }
+
+  return reflection;
+}
@@ -0,0 +1,137 @@
+#include <algorithm>
+
+#include "../hephics_core.hpp"
+
+// mip 6 is reduced by the last workgroup, so it must be at most 64x64
+static constexpr uint32_t g_max_source_size = 4096U;
+static constexpr uint32_t g_mid_mip_level = 6U;
+
+static hpxc::ImageViewInfo get_array_view_info(const hpxc::gpu::Image& image,
+                                               const uint32_t mip_level) {
+  hpxc::ImageViewInfo image_view_info{};
+  image_view_info.aspect = hpxc::ImageAspect::Color;
+  image_view_info.base_mip_level = mip_level;
+  image_view_info.mip_levels = 1U;
+  image_view_info.base_array_layer = 0U;
+  image_view_info.array_layers = image.getArrayLayers();
+  image_view_info.is_array = true;
+
+  return image_view_info;
+}
+
+hpxc::MipmapGenerator::MipmapGenerator(
+    const std::unique_ptr<gpu::Context>& ptr_context,
+    const std::string& file_path) {
+  m_shaderModuleMap["downsample"] =
+      io::shader::readModule(ptr_context, file_path);
+
+  m_ptrDescriptionUnit.reset(
+      new gpu::DescriptionUnit(m_shaderModuleMap, {"downsample"}));
+  m_ptrDescriptorSetLayout.reset(
+      new gpu::DescriptorSetLayout(ptr_context, *m_ptrDescriptionUnit));
+
+  m_ptrPipeline.reset(new gpu::Pipeline(ptr_context, *m_ptrDescriptionUnit,
+                                        *m_ptrDescriptorSetLayout));
+  m_ptrPipeline->constructComputePipeline(ptr_context,
+                                          m_shaderModuleMap.at("downsample"));
+
+  {
+    SamplerInfo sampler_info{};
+    sampler_info.address_mode_u = SamplerAddressMode::ClampToEdge;
+    sampler_info.address_mode_v = SamplerAddressMode::ClampToEdge;
+    sampler_info.address_mode_w = SamplerAddressMode::ClampToEdge;
+    sampler_info.mag_filter = SamplerFilter::Linear;
+    sampler_info.min_filter = SamplerFilter::Linear;
+    sampler_info.mipmap_mode = SamplerMipmapMode::Nearest;
+    sampler_info.mip_lod_bias = 0.0f;
+    sampler_info.anisotropy_enable = false;
+    sampler_info.compare_enable = false;
+    sampler_info.max_lod = 0.0f;
+    sampler_info.min_lod = 0.0f;
+    sampler_info.border_color = SamplerBorderColor::FloatOpaqueWhite;
+    sampler_info.unnormalized_coordinates = false;
+
+    m_ptrSampler.reset(new gpu::Sampler(ptr_context, sampler_info));
+  }
+}
+
+hpxc::MipmapGenerator::~MipmapGenerator() {}
+
+bool hpxc::MipmapGenerator::isSupported(const gpu::Image& image) const {
+  const auto required_usage =
+      vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eStorage;
+  const auto& graphical_size = image.getGraphicalSize();
+
+  return image.getFormat() == vk::Format::eR8G8B8A8Unorm &&
+         (image.getUsageFlags() & required_usage) == required_usage &&
+         image.getDimension() == ImageDimension::v2D &&
+         image.getMipLevels() > 1U &&
+         image.getMipLevels() <= MAX_GENERATED_LEVELS + 1U &&
+         graphical_size.width <= g_max_source_size &&
+         graphical_size.height <= g_max_source_size;
+}
+
+bool hpxc::MipmapGenerator::prepare(
+    const std::unique_ptr<gpu::Context>& ptr_context,
+    const gpu::Image& image) {
+  if (!isSupported(image)) {
+    return false;
+  }
+  if (m_targetMap.contains(image.getImage())) {
+    return true;
+  }
+
+  const auto last_mip_level = image.getMipLevels() - 1U;
+  const auto& descriptor_info_map =
+      m_ptrDescriptionUnit->getDescriptorInfoMap();
+
+  Target target;
+  target.ptr_src_view = std::make_unique<gpu::ImageView>(
+      ptr_context, image, get_array_view_info(image, 0U));
+  for (uint32_t mip_level = 1U; mip_level <= last_mip_level; mip_level += 1U) {
+    target.ptr_mip_views.push_back(std::make_unique<gpu::ImageView>(
+        ptr_context, image, get_array_view_info(image, mip_level)));
+  }
+
+  // one counter per array layer
+  target.ptr_counter_buffer.reset(createPtrStorageBuffer(
+      ptr_context, TransferType::TransferDst,
+      sizeof(uint32_t) * image.getArrayLayers()));
+
+  target.ptr_descriptor_set.reset(
+      new gpu::DescriptorSet(ptr_context, *m_ptrDescriptorSetLayout));
+
+  std::vector<gpu::BufferDescription> buffer_descriptions;
+  buffer_descriptions.emplace_back(descriptor_info_map.at("Counter"),
+                                   *target.ptr_counter_buffer);
+
+  std::vector<gpu::ImageDescription> image_descriptions;
+  image_descriptions.emplace_back(
+      descriptor_info_map.at("src_image"), *target.ptr_src_view,
+      ImageLayout::ShaderReadOnlyOptimal, *m_ptrSampler);
+  // every element must be valid,
+  //   levels which the image doesn't have are never written by shader
+  for (uint32_t idx = 0U; idx < MAX_GENERATED_LEVELS; idx += 1U) {
+    const auto mip_level = std::min(idx + 1U, last_mip_level);
+    image_descriptions.emplace_back(
+        descriptor_info_map.at("dst_mips"),
+        *target.ptr_mip_views.at(mip_level - 1U), ImageLayout::General, idx);
+  }
+  {
+    const auto mip_level = std::min(g_mid_mip_level, last_mip_level);
+    image_descriptions.emplace_back(descriptor_info_map.at("mid_mip"),
+                                    *target.ptr_mip_views.at(mip_level - 1U),
+                                    ImageLayout::General);
+  }
+
+  target.ptr_descriptor_set->updateDescriptorSet(
+      ptr_context, buffer_descriptions, image_descriptions);
+
+  m_targetMap.emplace(image.getImage(), std::move(target));
+
+  return true;
+}
+
+void hpxc::MipmapGenerator::release(const gpu::Image& image) {
+  m_targetMap.erase(image.getImage());
+}
@@ -0,0 +1,196 @@
+#include <filesystem>
+#include <iostream>
+#include <unordered_map>
+
+#include "../hephics_core.hpp"
+
+static std::filesystem::file_time_type get_last_write_time(
+    const std::string& file_path) {
+  std::error_code error_code;
+  const auto last_write_time =
+      std::filesystem::last_write_time(file_path, error_code);
+  if (error_code) {
+    // file may be replaced by editor now
+    return std::filesystem::file_time_type::min();
+  }
+
+  return last_write_time;
+}
+
+using WriteTimeMap =
+    std::unordered_map<std::string, std::filesystem::file_time_type>;
+
+static WriteTimeMap get_last_write_times(const std::string& file_path) {
+  WriteTimeMap write_times;
+  for (const auto& source_path : hpxc::io::shader::getSourcePaths(file_path)) {
+    write_times.insert({source_path, get_last_write_time(source_path)});
+  }
+
+  return write_times;
+}
+
+static bool is_source_changed(const WriteTimeMap& write_times) {
+  bool is_changed = false;
+  for (const auto& [source_path, write_time] : write_times) {
+    const auto current_write_time = get_last_write_time(source_path);
+    if (current_write_time == std::filesystem::file_time_type::min()) {
+      // wait until the editor finishes replacing the file
+      return false;
+    }
+    is_changed |= current_write_time != write_time;
+  }
+
+  return is_changed;
+}
+
+static bool is_compatible_interface(
+    const hpxc::gpu::DescriptionUnit& description_unit,
+    const hpxc::gpu::ShaderModule& shader_module) {
+  const auto& descriptor_info_map = description_unit.getDescriptorInfoMap();
+
+  for (const auto& [name, new_info] : shader_module.getDescriptorInfoMap()) {
+    const auto iter = descriptor_info_map.find(name);
+    if (iter == descriptor_info_map.end()) {
+      return false;
+    }
+
+    const auto& info = iter->second;
+    if (info.set != new_info.set || info.binding != new_info.binding ||
+        info.type != new_info.type) {
+      return false;
+    }
+    // runtime array is sized by application, not by shader
+    if (info.is_runtime_array != new_info.is_runtime_array ||
+        (!new_info.is_runtime_array && info.count != new_info.count)) {
+      return false;
+    }
+  }
+
+  // push constant ranges are baked into the shared pipeline layout
+  const auto& push_constant_range_map =
+      description_unit.getPushConstantRangeMap();
+
+  for (const auto& [name, new_range] :
+       shader_module.getPushConstantRangeMap()) {
+    const auto iter = push_constant_range_map.find(name);
+    if (iter == push_constant_range_map.end()) {
+      return false;
+    }
+
+    const auto& range = iter->second;
+    if (range.offset != new_range.offset || range.size != new_range.size) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+hpxc::ShaderHotReloader::ShaderHotReloader(
+    const std::unique_ptr<gpu::Context>& ptr_context,
+    const std::string& file_path, const gpu::DescriptionUnit& description_unit,
+    const gpu::DescriptorSetLayout& descriptor_set_layout,
+    const std::chrono::milliseconds poll_interval,
+    const SpecializationValueMap& specialization_values)
+    : m_ptrContext(ptr_context),
+      m_filePath(file_path),
+      m_descriptionUnit(description_unit),
+      m_descriptorSetLayout(descriptor_set_layout),
+      m_specializationValues(specialization_values),
+      m_pollInterval(poll_interval) {
+  build(m_ptrShaderModule, m_ptrPipeline);
+
+  m_watchThread = std::thread([this]() { watch(); });
+}
+
+hpxc::ShaderHotReloader::~ShaderHotReloader() {
+  {
+    std::lock_guard<std::mutex> lock(m_watchMutex);
+    m_isWatching = false;
+  }
+  m_watchCondition.notify_all();
+
+  if (m_watchThread.joinable()) {
+    m_watchThread.join();
+  }
+}
+
+void hpxc::ShaderHotReloader::build(
+    std::unique_ptr<gpu::ShaderModule>& ptr_shader_module,
+    std::unique_ptr<gpu::Pipeline>& ptr_pipeline) const {
+  ptr_shader_module = std::make_unique<gpu::ShaderModule>(
+      io::shader::readModule(m_ptrContext, m_filePath));
+  ptr_pipeline = std::make_unique<gpu::Pipeline>(
+      m_ptrContext, m_descriptionUnit, m_descriptorSetLayout);
+  ptr_pipeline->constructComputePipeline(m_ptrContext, *ptr_shader_module,
+                                         m_specializationValues);
+}
+
+void hpxc::ShaderHotReloader::watch() {
+  // included files are watched too, as they change the compiled shader
+  auto write_times = get_last_write_times(m_filePath);
+
+  std::unique_lock<std::mutex> lock(m_watchMutex);
+  while (m_isWatching) {
+    m_watchCondition.wait_for(lock, m_pollInterval);
+    if (!m_isWatching) {
+      break;
+    }
+
+    if (!is_source_changed(write_times)) {
+      continue;
+    }
+    // includes may be added or removed by the edit
+    write_times = get_last_write_times(m_filePath);
+
+    // compile without holding the lock, destructor must not wait for it
+    lock.unlock();
+
+    std::unique_ptr<gpu::ShaderModule> ptr_shader_module;
+    std::unique_ptr<gpu::Pipeline> ptr_pipeline;
+    try {
+      build(ptr_shader_module, ptr_pipeline);
+
+      if (!is_compatible_interface(m_descriptionUnit, *ptr_shader_module)) {
+        throw std::runtime_error(
+            "descriptor bindings or push constants are changed, "
+            "restart is required.");
+      }
+
+      std::lock_guard<std::mutex> pending_lock(m_pendingMutex);
+      // previous pending pipeline is never used by gpu
+      m_ptrPendingShaderModule = std::move(ptr_shader_module);
+      m_ptrPendingPipeline = std::move(ptr_pipeline);
+    } catch (const std::exception& error) {
+      std::cerr << "failed to reload shader: " << m_filePath << std::endl;
+      std::cerr << error.what() << std::endl;
+    }
+
+    lock.lock();
+  }
+}
+
+bool hpxc::ShaderHotReloader::swapPipeline(const uint64_t frame_index) {
+  std::lock_guard<std::mutex> lock(m_pendingMutex);
+  if (!m_ptrPendingPipeline) {
+    return false;
+  }
+
+  RetiredPipeline retired_pipeline;
+  retired_pipeline.ptr_shader_module = std::move(m_ptrShaderModule);
+  retired_pipeline.ptr_pipeline = std::move(m_ptrPipeline);
+  retired_pipeline.last_used_frame = frame_index == 0U ? 0U : frame_index - 1U;
+  m_retiredPipelines.push_back(std::move(retired_pipeline));
+
+  m_ptrShaderModule = std::move(m_ptrPendingShaderModule);
+  m_ptrPipeline = std::move(m_ptrPendingPipeline);
+
+  return true;
+}
+
+void hpxc::ShaderHotReloader::releaseRetiredPipelines(
+    const uint64_t completed_frame_index) {
+  std::erase_if(m_retiredPipelines, [&](const RetiredPipeline& retired) {
+    return retired.last_used_frame <= completed_frame_index;
+  });
+}
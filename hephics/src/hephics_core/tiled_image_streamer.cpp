@@ -0,0 +1,277 @@
+#include <algorithm>
+#include <cstring>
+
+#include "../hephics_core.hpp"
+#include "gpu/vk_helper.hpp"
+
+static hpxc::ImageSubInfo get_tile_sub_info(const uint32_t tile_extent,
+                                            const hpxc::ImageFormat format) {
+  hpxc::ImageSubInfo image_sub_info;
+  image_sub_info.graphical_size.width = tile_extent;
+  image_sub_info.graphical_size.height = tile_extent;
+  image_sub_info.graphical_size.depth = 1U;
+  image_sub_info.mip_levels = 1U;
+  image_sub_info.array_layers = 1U;
+  image_sub_info.samples = hpxc::ImageSampleCount::v1;
+  image_sub_info.format = format;
+  image_sub_info.dimension = hpxc::ImageDimension::v2D;
+
+  return image_sub_info;
+}
+
+static hpxc::ImageViewInfo get_tile_view_info() {
+  hpxc::ImageViewInfo image_view_info{};
+  image_view_info.aspect = hpxc::ImageAspect::Color;
+  image_view_info.base_mip_level = 0U;
+  image_view_info.mip_levels = 1U;
+  image_view_info.base_array_layer = 0U;
+  image_view_info.array_layers = 1U;
+
+  return image_view_info;
+}
+
+hpxc::TiledImageStreamer::TiledImageStreamer(
+    const std::unique_ptr<gpu::Context>& ptr_context,
+    const TileStreamInfo& tile_stream_info,
+    const std::vector<ImageUsage>& src_usages,
+    const std::vector<ImageUsage>& dst_usages)
+    : m_tileStreamInfo(tile_stream_info),
+      m_srcTexelSize(vk_helper::getTexelSize(
+          vk_helper::getImageFormat(tile_stream_info.src_format))),
+      m_dstTexelSize(vk_helper::getTexelSize(
+          vk_helper::getImageFormat(tile_stream_info.dst_format))) {
+  if (m_tileStreamInfo.tile_size == 0U || m_tileStreamInfo.slot_count == 0U) {
+    throw std::runtime_error("tile size and slot count must not be 0.");
+  }
+  if (m_srcTexelSize == 0U || m_dstTexelSize == 0U) {
+    throw std::runtime_error("tile format has no texel size.");
+  }
+
+  const auto src_tile_extent =
+      m_tileStreamInfo.tile_size + m_tileStreamInfo.halo_size * 2U;
+  const auto max_image_dimension = ptr_context->getDevice()
+                                       ->getPhysicalDevice()
+                                       .getProperties()
+                                       .limits.maxImageDimension2D;
+  if (src_tile_extent > max_image_dimension) {
+    throw std::runtime_error("tile with halo exceeds maxImageDimension2D: " +
+                             std::to_string(max_image_dimension));
+  }
+
+  const auto src_sub_info =
+      get_tile_sub_info(src_tile_extent, m_tileStreamInfo.src_format);
+  const auto dst_sub_info = get_tile_sub_info(m_tileStreamInfo.tile_size,
+                                              m_tileStreamInfo.dst_format);
+  const auto image_view_info = get_tile_view_info();
+
+  m_slots.resize(m_tileStreamInfo.slot_count);
+  for (auto& slot : m_slots) {
+    slot.ptr_src_image.reset(new gpu::Image(
+        ptr_context, MemoryUsage::GpuOnly, TransferType::TransferDst,
+        src_usages, src_sub_info));
+    slot.ptr_dst_image.reset(new gpu::Image(
+        ptr_context, MemoryUsage::GpuOnly, TransferType::TransferSrc,
+        dst_usages, dst_sub_info));
+    slot.ptr_src_image_view.reset(new gpu::ImageView(
+        ptr_context, *slot.ptr_src_image, image_view_info));
+    slot.ptr_dst_image_view.reset(new gpu::ImageView(
+        ptr_context, *slot.ptr_dst_image, image_view_info));
+
+    slot.ptr_upload_buffer.reset(createPtrStagingBufferToGPU(
+        ptr_context, static_cast<size_t>(src_tile_extent) * src_tile_extent *
+                         m_srcTexelSize));
+    slot.ptr_readback_buffer.reset(createPtrStagingBufferFromGPU(
+        ptr_context, static_cast<size_t>(m_tileStreamInfo.tile_size) *
+                         m_tileStreamInfo.tile_size * m_dstTexelSize));
+
+    slot.ptr_command_driver.reset(
+        new CommandDriver(ptr_context, QueueFamilyType::Compute));
+    slot.ptr_semaphore.reset(new gpu::Semaphore(ptr_context));
+  }
+}
+
+hpxc::TiledImageStreamer::~TiledImageStreamer() {}
+
+void hpxc::TiledImageStreamer::recordTileCommands(
+    const Slot& slot, const TileInfo& tile_info,
+    const ComputeFunction& compute_function) const {
+  const auto command_buffer = slot.ptr_command_driver->getCompute();
+  const auto image_view_info = get_tile_view_info();
+
+  command_buffer.begin();
+
+  // previous tile of this slot is completed, so contents are discarded
+  {
+    const gpu::ImageBarrier image_barrier(
+        *slot.ptr_src_image, {AccessFlag::Unknown}, {AccessFlag::TransferWrite},
+        ImageLayout::Undefined, ImageLayout::TransferDstOptimal,
+        image_view_info);
+    command_buffer.setPipelineBarrier(image_barrier, PipelineStage::TopOfPipe,
+                                      PipelineStage::Transfer);
+  }
+
+  {
+    ImageCopyRegion copy_region{};
+    copy_region.width = tile_info.loaded_width;
+    copy_region.height = tile_info.loaded_height;
+    copy_region.depth = 1U;
+    command_buffer.copyBufferToImage(
+        *slot.ptr_upload_buffer, *slot.ptr_src_image,
+        ImageLayout::TransferDstOptimal, image_view_info, copy_region);
+  }
+
+  {
+    const gpu::ImageBarrier image_barrier(
+        *slot.ptr_src_image, {AccessFlag::TransferWrite},
+        {AccessFlag::ShaderRead}, ImageLayout::TransferDstOptimal,
+        ImageLayout::General, image_view_info);
+    command_buffer.setPipelineBarrier(image_barrier, PipelineStage::Transfer,
+                                      PipelineStage::ComputeShader);
+  }
+  {
+    const gpu::ImageBarrier image_barrier(
+        *slot.ptr_dst_image, {AccessFlag::Unknown}, {AccessFlag::ShaderWrite},
+        ImageLayout::Undefined, ImageLayout::General, image_view_info);
+    command_buffer.setPipelineBarrier(image_barrier, PipelineStage::TopOfPipe,
+                                      PipelineStage::ComputeShader);
+  }
+
+  compute_function(command_buffer, tile_info);
+
+  {
+    const gpu::ImageBarrier image_barrier(
+        *slot.ptr_dst_image, {AccessFlag::ShaderWrite},
+        {AccessFlag::TransferRead}, ImageLayout::General,
+        ImageLayout::TransferSrcOptimal, image_view_info);
+    command_buffer.setPipelineBarrier(image_barrier,
+                                      PipelineStage::ComputeShader,
+                                      PipelineStage::Transfer);
+  }
+
+  {
+    ImageCopyRegion copy_region{};
+    copy_region.width = tile_info.width;
+    copy_region.height = tile_info.height;
+    copy_region.depth = 1U;
+    command_buffer.copyImageToBuffer(
+        *slot.ptr_dst_image, *slot.ptr_readback_buffer,
+        ImageLayout::TransferSrcOptimal, image_view_info, copy_region);
+  }
+
+  {
+    const gpu::BufferBarrier buffer_barrier(*slot.ptr_readback_buffer,
+                                            {AccessFlag::TransferWrite},
+                                            {AccessFlag::HostRead});
+    command_buffer.setPipelineBarrier(buffer_barrier, PipelineStage::Transfer,
+                                      PipelineStage::Host);
+  }
+
+  command_buffer.end();
+}
+
+void hpxc::TiledImageStreamer::finishTile(
+    const std::unique_ptr<gpu::Context>& ptr_context, Slot& slot,
+    std::byte* ptr_dst, const size_t dst_row_pitch) {
+  if (!slot.pending_tile.has_value()) {
+    return;
+  }
+
+  slot.ptr_semaphore->wait(ptr_context);
+
+  const auto& tile_info = slot.pending_tile.value();
+  const auto texel_size = m_dstTexelSize;
+  const auto row_size = static_cast<size_t>(tile_info.width) * texel_size;
+
+  const auto ptr_readback = static_cast<const std::byte*>(
+      slot.ptr_readback_buffer->mapMemory(ptr_context));
+  // readback memory is host cached, not coherent
+  slot.ptr_readback_buffer->invalidateMemory(ptr_context);
+  for (uint32_t row = 0U; row < tile_info.height; row += 1U) {
+    const auto dst_offset = (tile_info.y + row) * dst_row_pitch +
+                            static_cast<size_t>(tile_info.x) * texel_size;
+    std::memcpy(ptr_dst + dst_offset, ptr_readback + row * row_size,
+                row_size);
+  }
+  slot.ptr_readback_buffer->unmapMemory(ptr_context);
+
+  slot.pending_tile.reset();
+}
+
+void hpxc::TiledImageStreamer::stream(
+    const std::unique_ptr<gpu::Context>& ptr_context, const void* ptr_src,
+    void* ptr_dst, const uint32_t width, const uint32_t height,
+    const ComputeFunction& compute_function, const size_t src_row_pitch,
+    const size_t dst_row_pitch) {
+  const auto ptr_src_bytes = static_cast<const std::byte*>(ptr_src);
+  const auto ptr_dst_bytes = static_cast<std::byte*>(ptr_dst);
+  const auto tile_size = m_tileStreamInfo.tile_size;
+  const auto halo_size = m_tileStreamInfo.halo_size;
+  const auto texel_size = m_srcTexelSize;
+  const auto src_pitch = src_row_pitch == 0U
+                             ? static_cast<size_t>(width) * texel_size
+                             : src_row_pitch;
+  const auto dst_pitch = dst_row_pitch == 0U
+                             ? static_cast<size_t>(width) * m_dstTexelSize
+                             : dst_row_pitch;
+  if (src_pitch < static_cast<size_t>(width) * texel_size ||
+      dst_pitch < static_cast<size_t>(width) * m_dstTexelSize) {
+    throw std::runtime_error("row pitch must not be less than row size.");
+  }
+
+  const auto tile_count_x = (width + tile_size - 1U) / tile_size;
+  const auto tile_count_y = (height + tile_size - 1U) / tile_size;
+  const auto tile_count = tile_count_x * tile_count_y;
+
+  for (uint32_t tile_index = 0U; tile_index < tile_count; tile_index += 1U) {
+    const auto slot_index =
+        tile_index % static_cast<uint32_t>(m_slots.size());
+    auto& slot = m_slots.at(slot_index);
+
+    // the slot is reused, so its previous tile must be written back
+    finishTile(ptr_context, slot, ptr_dst_bytes, dst_pitch);
+
+    TileInfo tile_info;
+    tile_info.index = tile_index;
+    tile_info.slot_index = slot_index;
+    tile_info.x = (tile_index % tile_count_x) * tile_size;
+    tile_info.y = (tile_index / tile_count_x) * tile_size;
+    tile_info.width = std::min(tile_size, width - tile_info.x);
+    tile_info.height = std::min(tile_size, height - tile_info.y);
+
+    // halo is clamped at image edge
+    const auto load_x = tile_info.x - std::min(halo_size, tile_info.x);
+    const auto load_y = tile_info.y - std::min(halo_size, tile_info.y);
+    tile_info.src_offset_x = tile_info.x - load_x;
+    tile_info.src_offset_y = tile_info.y - load_y;
+    tile_info.loaded_width =
+        std::min(tile_info.x + tile_info.width + halo_size, width) - load_x;
+    tile_info.loaded_height =
+        std::min(tile_info.y + tile_info.height + halo_size, height) - load_y;
+
+    {
+      const auto row_size =
+          static_cast<size_t>(tile_info.loaded_width) * texel_size;
+      const auto ptr_upload = static_cast<std::byte*>(
+          slot.ptr_upload_buffer->mapMemory(ptr_context));
+      for (uint32_t row = 0U; row < tile_info.loaded_height; row += 1U) {
+        const auto src_offset = (load_y + row) * src_pitch +
+                                static_cast<size_t>(load_x) * texel_size;
+        std::memcpy(ptr_upload + row * row_size, ptr_src_bytes + src_offset,
+                    row_size);
+      }
+      slot.ptr_upload_buffer->flushMemory(ptr_context);
+      slot.ptr_upload_buffer->unmapMemory(ptr_context);
+    }
+
+    slot.ptr_command_driver->resetAllCommands();
+    recordTileCommands(slot, tile_info, compute_function);
+    slot.ptr_command_driver->submit(PipelineStage::Transfer,
+                                    *slot.ptr_semaphore);
+
+    slot.pending_tile = tile_info;
+  }
+
+  for (auto& slot : m_slots) {
+    finishTile(ptr_context, slot, ptr_dst_bytes, dst_pitch);
+  }
+}
@@ -1,8 +1,39 @@
+#include <iostream>
+#include <string>
+
+#include "samples/hephics_core/basic_computing.hpp"
 #include "samples/hephics_core/computing_frames_handle.h"
+#include "samples/hephics_core/shader_optimization_benchmark.hpp"
+#include "samples/hephics_core/simple_image_computing.hpp"
+#include "samples/hephics_core/subgroup_computing.hpp"
+
+template <typename Sample>
+static void run_sample() {
+  Sample sample;
+  sample.run();
+}
+
+// usage: hephics [frames|basic|image|subgroup|benchmark] (default: frames)
+int main(int argc, char* argv[]) {
+  const std::string sample_name = argc > 1 ? argv[1] : "frames";
+
+  if (sample_name == "frames") {
+    run_sample<samples::core::ComputingFramesHandle>();
+  } else if (sample_name == "basic") {
+    run_sample<samples::core::BasicComputing>();
+  } else if (sample_name == "image") {
+    run_sample<samples::core::SimpleImageComputing>();
+  } else if (sample_name == "subgroup") {
+    run_sample<samples::core::SubgroupComputing>();
+  } else if (sample_name == "benchmark") {
+    run_sample<samples::core::ShaderOptimizationBenchmark>();
+  } else {
+    std::cerr << "unknown sample: " << sample_name << std::endl;
+    std::cerr << "samples: frames, basic, image, subgroup, benchmark"
+              << std::endl;
 
-int main() {
-  samples::core::ComputingFramesHandle computing_frames_handle;
-  computing_frames_handle.run();
+    return 1;
+  }
 
   return 0;
 }
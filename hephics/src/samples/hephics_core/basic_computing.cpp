@@ -36,13 +36,9 @@ samples::core::BasicComputing::BasicComputing() {
   m_ptrTransferCommandDriver.reset(
       new hpxc::CommandDriver(m_ptrContext, hpxc::QueueFamilyType::Transfer));
 
-  m_ptrUniformBuffer.reset(
-      hpxc::createPtrUniformBuffer(m_ptrContext, sizeof(float_t)));
-  const auto uniform_mapped_address =
-      m_ptrUniformBuffer->mapMemory(m_ptrContext);
-  std::fill_n(reinterpret_cast<float_t*>(uniform_mapped_address),
-              m_ptrUniformBuffer->getSize() / sizeof(float_t), 3.14f);
-  m_ptrUniformBuffer->unmapMemory(m_ptrContext);
+  // small uniform data of many dispatches shares one buffer
+  m_ptrUniformArena.reset(new hpxc::gpu::UniformArena(m_ptrContext, 4096U));
+  m_uniformOffset = m_ptrUniformArena->push(3.14f);
 
   m_ptrInputStorageBuffer.reset(hpxc::createPtrStorageBuffer(
       m_ptrContext, hpxc::TransferType::TransferDst, sizeof(uint32_t) * 1024U));
@@ -176,14 +172,12 @@ void samples::core::BasicComputing::setTransferCommands(
 }
 
 void samples::core::BasicComputing::constructShaderResources() {
-  const auto spirv_binary =
-      hpxc::io::shader::read("shaders/compute/basic.comp");
+  m_shaderModuleMap["compute"] = hpxc::io::shader::readModule(
+      m_ptrContext, "shaders/compute/basic.comp");
 
-  m_shaderModuleMap["compute"] =
-      hpxc::gpu::ShaderModule(m_ptrContext, spirv_binary);
-
-  const auto description_unit =
+  auto description_unit =
       hpxc::gpu::DescriptionUnit(m_shaderModuleMap, {"compute"});
+  description_unit.setDynamicBuffer("UniformNumber");
 
   m_ptrDescriptorSetLayout.reset(
       new hpxc::gpu::DescriptorSetLayout(m_ptrContext, description_unit));
@@ -194,7 +188,7 @@ void samples::core::BasicComputing::constructShaderResources() {
   std::vector<hpxc::gpu::BufferDescription> buffer_descriptions;
   buffer_descriptions.emplace_back(
       description_unit.getDescriptorInfoMap().at("UniformNumber"),
-      *m_ptrUniformBuffer);
+      m_ptrUniformArena->getBuffer());
   buffer_descriptions.emplace_back(
       description_unit.getDescriptorInfoMap().at("Output"),
       *m_ptrOutputStorageBuffer);
@@ -248,8 +242,10 @@ void samples::core::BasicComputing::setComputeCommands(
                                       hpxc::PipelineStage::ComputeShader);
   }
 
+  const uint32_t dynamic_offsets[] = {m_uniformOffset};
   command_buffer.compute(*m_ptrComputePipeline, *m_ptrDescriptorSet,
-                         hpxc::ComputeWorkGroupSize{4U, 1U, 1U});
+                         hpxc::ComputeWorkGroupSize{4U, 1U, 1U},
+                         dynamic_offsets);
 
   {
     const auto buffer_barrier = hpxc::gpu::BufferBarrier(
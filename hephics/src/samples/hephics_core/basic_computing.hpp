@@ -16,7 +16,8 @@ class BasicComputing {
   std::unique_ptr<hpxc::CommandDriver> m_ptrComputeCommandDriver;
   std::unique_ptr<hpxc::CommandDriver> m_ptrTransferCommandDriver;
 
-  std::unique_ptr<hpxc::gpu::Buffer> m_ptrUniformBuffer;
+  std::unique_ptr<hpxc::gpu::UniformArena> m_ptrUniformArena;
+  uint32_t m_uniformOffset = 0U;
   std::unique_ptr<hpxc::gpu::Buffer> m_ptrInputStorageBuffer;
   std::unique_ptr<hpxc::gpu::Buffer> m_ptrOutputStorageBuffer;
 
@@ -1,5 +1,10 @@
 #include "computing_frames_handle.h"
 
+// same layout as PushTimer block in shaders/compute/simple_image.comp
+struct PushTimer {
+  float_t time;
+};
+
 static uint32_t calculate_mip_levels(
     const hpxc::gpu_ui_connection::GraphicalSize<uint32_t>& size) {
   return static_cast<uint32_t>(
@@ -47,7 +52,9 @@ void samples::core::ComputingFramesHandle::run() {
   }
 
   // computing loop
-  while (true) {
+  for (uint64_t frame_index = 0U;; frame_index++) {
+    m_ptrShaderHotReloader->swapPipeline(frame_index);
+
     const auto result_buffer = hpxc::createStagingBufferFromGPU(
         m_ptrContext, m_image.total() * m_image.elemSize());
     setComputeCommands(result_buffer);
@@ -55,6 +62,7 @@ void samples::core::ComputingFramesHandle::run() {
     m_ptrComputeCommandDriver->submit(hpxc::PipelineStage::ComputeShader,
                                       semaphore);
     semaphore.wait(m_ptrContext);
+    m_ptrShaderHotReloader->releaseRetiredPipelines(frame_index);
 
     const auto result_mapped_address = result_buffer.mapMemory(m_ptrContext);
     const auto& image_size = m_ptrStorageImage->getGraphicalSize();
@@ -91,10 +99,11 @@ void samples::core::ComputingFramesHandle::initializeImageResources() {
   image_sub_info.format = hpxc::ImageFormat::R8G8B8A8Unorm;
   image_sub_info.dimension = hpxc::ImageDimension::v2D;
 
-  m_ptrImage.reset(
-      new hpxc::gpu::Image(m_ptrContext, hpxc::MemoryUsage::GpuOnly,
-                           hpxc::TransferType::TransferSrcDst,
-                           {hpxc::ImageUsage::Sampled}, image_sub_info));
+  // storage usage is for mipmaps written by the downsampler
+  m_ptrImage.reset(new hpxc::gpu::Image(
+      m_ptrContext, hpxc::MemoryUsage::GpuOnly,
+      hpxc::TransferType::TransferSrcDst,
+      {hpxc::ImageUsage::Sampled, hpxc::ImageUsage::Storage}, image_sub_info));
 
   m_ptrStorageImage.reset(
       new hpxc::gpu::Image(m_ptrContext, hpxc::MemoryUsage::GpuOnly,
@@ -137,11 +146,8 @@ void samples::core::ComputingFramesHandle::initializeImageResources() {
 }
 
 void samples::core::ComputingFramesHandle::constructShaderResources() {
-  const auto spirv_binary =
-      hpxc::io::shader::read("shaders/compute/simple_image.comp");
-
-  m_shaderModuleMap["compute"] =
-      hpxc::gpu::ShaderModule(m_ptrContext, spirv_binary);
+  m_shaderModuleMap["compute"] = hpxc::io::shader::readModule(
+      m_ptrContext, "shaders/compute/simple_image.comp");
 
   const auto description_unit =
       hpxc::gpu::DescriptionUnit(m_shaderModuleMap, {"compute"});
@@ -167,10 +173,14 @@ void samples::core::ComputingFramesHandle::constructShaderResources() {
   m_ptrDescriptorSet->updateDescriptorSet(m_ptrContext, buffer_descriptions,
                                           image_descriptions);
 
-  m_ptrComputePipeline.reset(new hpxc::gpu::Pipeline(
-      m_ptrContext, description_unit, *m_ptrDescriptorSetLayout));
-  m_ptrComputePipeline->constructComputePipeline(
-      m_ptrContext, m_shaderModuleMap.at("compute"));
+  // unsupported image falls back to blit chain in generateMipmaps
+  m_ptrMipmapGenerator.reset(new hpxc::MipmapGenerator(m_ptrContext));
+  m_ptrMipmapGenerator->prepare(m_ptrContext, *m_ptrImage);
+
+  // editing the shader file while running updates the result
+  m_ptrShaderHotReloader.reset(new hpxc::ShaderHotReloader(
+      m_ptrContext, "shaders/compute/simple_image.comp", description_unit,
+      *m_ptrDescriptorSetLayout));
 }
 
 void samples::core::ComputingFramesHandle::setResourceTransferCommands(
@@ -202,9 +212,7 @@ void samples::core::ComputingFramesHandle::setResourceTransferCommands(
                                    hpxc::ImageLayout::TransferDstOptimal,
                                    image_view_info);
 
-  // mipmap generation and release the ownership
-  command_buffer.setMipmaps(*m_ptrImage, hpxc::PipelineStage::Transfer);
-
+  // mipmaps are generated on compute queue, so release the ownership
   command_buffer.transferMipmapImages(
       *m_ptrImage, hpxc::PipelineStage::Transfer,
       hpxc::PipelineStage::BottomOfPipe,
@@ -218,11 +226,26 @@ void samples::core::ComputingFramesHandle::setResourceReceiveCommands() {
   const auto command_buffer = m_ptrComputeCommandDriver->getCompute();
   command_buffer.begin();
 
-  command_buffer.acquireMipmapImages(
-      *m_ptrImage, hpxc::PipelineStage::BottomOfPipe,
-      hpxc::PipelineStage::ComputeShader,
-      {m_ptrTransferCommandDriver->getQueueFamilyIndex(),
-       m_ptrComputeCommandDriver->getQueueFamilyIndex()});
+  // all levels stay TransferDstOptimal for generateMipmaps
+  {
+    auto image_barrier = hpxc::gpu::ImageBarrier(
+        *m_ptrImage, {hpxc::AccessFlag::TransferWrite},
+        {hpxc::AccessFlag::TransferWrite},
+        hpxc::ImageLayout::TransferDstOptimal,
+        hpxc::ImageLayout::TransferDstOptimal,
+        m_ptrImageView->getImageViewInfo());
+    image_barrier.setSrcQueueFamilyIndex(
+        m_ptrTransferCommandDriver->getQueueFamilyIndex());
+    image_barrier.setDstQueueFamilyIndex(
+        m_ptrComputeCommandDriver->getQueueFamilyIndex());
+
+    command_buffer.setPipelineBarrier(image_barrier,
+                                      hpxc::PipelineStage::BottomOfPipe,
+                                      hpxc::PipelineStage::Transfer);
+  }
+
+  command_buffer.generateMipmaps(*m_ptrMipmapGenerator, *m_ptrImage,
+                                 hpxc::PipelineStage::ComputeShader);
 
   const hpxc::ImageViewInfo image_view_info =
       m_ptrStorageImageView->getImageViewInfo();
@@ -247,9 +270,9 @@ void samples::core::ComputingFramesHandle::setComputeCommands(
   const auto command_buffer = m_ptrComputeCommandDriver->getCompute();
   command_buffer.begin();
 
-  command_buffer.pushConstants(*m_ptrComputePipeline,
-                               {hpxc::ShaderStage::Compute}, 0U, {push_timer});
-  command_buffer.compute(*m_ptrComputePipeline, *m_ptrDescriptorSet,
+  const auto& compute_pipeline = m_ptrShaderHotReloader->getPipeline();
+  command_buffer.pushConstants(compute_pipeline, PushTimer{push_timer});
+  command_buffer.compute(compute_pipeline, *m_ptrDescriptorSet,
                          hpxc::ComputeWorkGroupSize{
                              m_ptrImage->getGraphicalSize().width / 4U,
                              m_ptrImage->getGraphicalSize().height / 4U, 1U});
@@ -24,6 +24,8 @@ class ComputingFramesHandle {
 
   std::unique_ptr<hpxc::gpu::Sampler> m_ptrImageSampler;
 
+  std::unique_ptr<hpxc::MipmapGenerator> m_ptrMipmapGenerator;
+
   std::unique_ptr<hpxc::CommandDriver> m_ptrComputeCommandDriver;
   std::unique_ptr<hpxc::CommandDriver> m_ptrTransferCommandDriver;
 
@@ -32,7 +34,7 @@ class ComputingFramesHandle {
   std::unique_ptr<hpxc::gpu::DescriptorSetLayout> m_ptrDescriptorSetLayout;
 
   std::unique_ptr<hpxc::gpu::DescriptorSet> m_ptrDescriptorSet;
-  std::unique_ptr<hpxc::gpu::Pipeline> m_ptrComputePipeline;
+  std::unique_ptr<hpxc::ShaderHotReloader> m_ptrShaderHotReloader;
 
   cv::Mat m_image;
 
@@ -0,0 +1,129 @@
+#include "shader_optimization_benchmark.hpp"
+
+#include <chrono>
+#include <format>
+#include <iostream>
+
+constexpr uint32_t ELEMENT_COUNT = 1U << 20U;
+constexpr uint32_t LOCAL_SIZE_X = 256U;
+constexpr uint32_t DISPATCH_COUNT = 64U;
+constexpr uint32_t MEASURE_COUNT = 10U;
+
+static const std::vector<
+    std::pair<std::string, hpxc::io::shader::Optimization>>
+    g_optimization_levels = {
+        {"none", hpxc::io::shader::Optimization::None},
+        {"performance", hpxc::io::shader::Optimization::Performance},
+        {"size", hpxc::io::shader::Optimization::Size},
+};
+
+samples::core::ShaderOptimizationBenchmark::ShaderOptimizationBenchmark() {
+  m_ptrContext = std::make_unique<hpxc::gpu::Context>(nullptr);
+
+  m_ptrComputeCommandDriver.reset(
+      new hpxc::CommandDriver(m_ptrContext, hpxc::QueueFamilyType::Compute));
+
+  m_ptrOutputStorageBuffer.reset(hpxc::createPtrStorageBuffer(
+      m_ptrContext, hpxc::TransferType::TransferSrc,
+      sizeof(float_t) * ELEMENT_COUNT));
+}
+
+samples::core::ShaderOptimizationBenchmark::~ShaderOptimizationBenchmark() {
+  m_ptrContext->getDevice()->waitIdle();
+}
+
+void samples::core::ShaderOptimizationBenchmark::run() {
+  constructShaderResources();
+
+  for (const auto& [level_name, _] : g_optimization_levels) {
+    const auto& pipeline = *m_computePipelineMap.at(level_name);
+
+    // warm up
+    measure(pipeline);
+
+    double_t total_milliseconds = 0.0;
+    for (uint32_t idx = 0U; idx < MEASURE_COUNT; idx += 1U) {
+      total_milliseconds += measure(pipeline);
+    }
+
+    std::cout << std::format(
+                     "{:>12}: {:.3f} ms / {} dispatches", level_name,
+                     total_milliseconds / MEASURE_COUNT, DISPATCH_COUNT)
+              << std::endl;
+  }
+}
+
+void samples::core::ShaderOptimizationBenchmark::constructShaderResources() {
+  for (const auto& [level_name, optimization] : g_optimization_levels) {
+    m_shaderModuleMap[level_name] = hpxc::io::shader::readModule(
+        m_ptrContext, "shaders/compute/benchmark.comp", optimization);
+  }
+
+  // every level has the same interface
+  const auto description_unit =
+      hpxc::gpu::DescriptionUnit(m_shaderModuleMap, {"none"});
+
+  m_ptrDescriptorSetLayout.reset(
+      new hpxc::gpu::DescriptorSetLayout(m_ptrContext, description_unit));
+
+  m_ptrDescriptorSet.reset(
+      new hpxc::gpu::DescriptorSet(m_ptrContext, *m_ptrDescriptorSetLayout));
+
+  std::vector<hpxc::gpu::BufferDescription> buffer_descriptions;
+  buffer_descriptions.emplace_back(
+      description_unit.getDescriptorInfoMap().at("Output"),
+      *m_ptrOutputStorageBuffer);
+
+  m_ptrDescriptorSet->updateDescriptorSet(m_ptrContext, buffer_descriptions,
+                                          {});
+
+  for (const auto& [level_name, _] : g_optimization_levels) {
+    auto& ptr_pipeline = m_computePipelineMap[level_name];
+    ptr_pipeline.reset(new hpxc::gpu::Pipeline(m_ptrContext, description_unit,
+                                               *m_ptrDescriptorSetLayout));
+    ptr_pipeline->constructComputePipeline(m_ptrContext,
+                                           m_shaderModuleMap.at(level_name));
+  }
+}
+
+void samples::core::ShaderOptimizationBenchmark::setComputeCommands(
+    const hpxc::gpu::Pipeline& pipeline) {
+  const auto command_buffer = m_ptrComputeCommandDriver->getCompute();
+
+  command_buffer.begin();
+
+  for (uint32_t idx = 0U; idx < DISPATCH_COUNT; idx += 1U) {
+    command_buffer.compute(
+        pipeline, *m_ptrDescriptorSet,
+        hpxc::ComputeWorkGroupSize{ELEMENT_COUNT / LOCAL_SIZE_X, 1U, 1U});
+
+    // serialize dispatches, so that total time is sum of kernel runtimes
+    const auto buffer_barrier = hpxc::gpu::BufferBarrier(
+        *m_ptrOutputStorageBuffer, {hpxc::AccessFlag::ShaderWrite},
+        {hpxc::AccessFlag::ShaderWrite});
+
+    command_buffer.setPipelineBarrier(buffer_barrier,
+                                      hpxc::PipelineStage::ComputeShader,
+                                      hpxc::PipelineStage::ComputeShader);
+  }
+
+  command_buffer.end();
+}
+
+double_t samples::core::ShaderOptimizationBenchmark::measure(
+    const hpxc::gpu::Pipeline& pipeline) {
+  setComputeCommands(pipeline);
+
+  hpxc::gpu::Semaphore semaphore(m_ptrContext);
+
+  const auto start_time = std::chrono::steady_clock::now();
+  m_ptrComputeCommandDriver->submit(hpxc::PipelineStage::ComputeShader,
+                                    semaphore);
+  semaphore.wait(m_ptrContext);
+  const auto end_time = std::chrono::steady_clock::now();
+
+  m_ptrComputeCommandDriver->resetAllCommandPools(m_ptrContext);
+
+  return std::chrono::duration<double_t, std::milli>(end_time - start_time)
+      .count();
+}
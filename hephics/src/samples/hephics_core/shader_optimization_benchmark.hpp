@@ -0,0 +1,46 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "../../hephics_core.hpp"
+
+namespace samples {
+namespace core {
+
+/// <summary>
+/// Compare kernel runtimes of spirv-opt levels.
+/// </summary>
+class ShaderOptimizationBenchmark {
+ private:
+  std::unique_ptr<hpxc::gpu::Context> m_ptrContext;
+
+  std::unique_ptr<hpxc::CommandDriver> m_ptrComputeCommandDriver;
+
+  std::unique_ptr<hpxc::gpu::Buffer> m_ptrOutputStorageBuffer;
+
+  hpxc::ShaderModuleMap m_shaderModuleMap;
+
+  std::unique_ptr<hpxc::gpu::DescriptorSetLayout> m_ptrDescriptorSetLayout;
+
+  std::unique_ptr<hpxc::gpu::DescriptorSet> m_ptrDescriptorSet;
+  std::unordered_map<std::string, std::unique_ptr<hpxc::gpu::Pipeline>>
+      m_computePipelineMap;
+
+ public:
+  ShaderOptimizationBenchmark();
+
+  ~ShaderOptimizationBenchmark();
+
+  void run();
+
+ private:
+  void constructShaderResources();
+  void setComputeCommands(const hpxc::gpu::Pipeline& pipeline);
+
+  double_t measure(const hpxc::gpu::Pipeline& pipeline);
+};
+
+}  // namespace core
+}  // namespace samples
@@ -1,12 +1,15 @@
 #include "simple_image_computing.hpp"
 
+// same layout as PushTimer block in shaders/compute/simple_image.comp
+struct PushTimer {
+  float_t time;
+};
+
 samples::core::SimpleImageComputing::SimpleImageComputing() {
   m_ptrContext = std::make_unique<hpxc::gpu::Context>(nullptr);
 
   m_ptrComputeCommandDriver.reset(
       new hpxc::CommandDriver(m_ptrContext, hpxc::QueueFamilyType::Compute));
-  m_ptrTransferCommandDriver.reset(
-      new hpxc::CommandDriver(m_ptrContext, hpxc::QueueFamilyType::Transfer));
 
   m_ptrUniformBuffer.reset(
       hpxc::createPtrUniformBuffer(m_ptrContext, sizeof(float_t)));
@@ -26,26 +29,24 @@ samples::core::SimpleImageComputing::~SimpleImageComputing() {
 void samples::core::SimpleImageComputing::run() {
   hpxc::gpu::Semaphore semaphore(m_ptrContext);
 
-  const auto result_buffer = hpxc::createStagingBufferFromGPU(
-      m_ptrContext, m_image.total() * m_image.elemSize());
-  {
-    std::vector<hpxc::gpu::Buffer> staging_buffers;
-    setTransferCommands(staging_buffers);
+  // copied by cpu with VK_EXT_host_image_copy (ex> lavapipe),
+  //   otherwise by staging buffer
+  m_ptrImage->copyFromHost(m_ptrContext, m_image.data,
+                           m_image.total() * m_image.elemSize(),
+                           m_ptrImageView->getImageViewInfo(),
+                           hpxc::ImageLayout::ShaderReadOnlyOptimal);
 
-    setComputeCommands(result_buffer);
+  setComputeCommands();
+  m_ptrComputeCommandDriver->submit(hpxc::PipelineStage::ComputeShader,
+                                    semaphore);
+  semaphore.wait(m_ptrContext);
 
-    m_ptrTransferCommandDriver->submit(hpxc::PipelineStage::BottomOfPipe,
-                                       semaphore);
-    m_ptrComputeCommandDriver->submit(hpxc::PipelineStage::ComputeShader,
-                                      semaphore);
-    semaphore.wait(m_ptrContext);
-  }
-
-  const auto result_mapped_address = result_buffer.mapMemory(m_ptrContext);
   const auto& image_size = m_ptrStorageImage->getGraphicalSize();
-  cv::Mat result(image_size.height, image_size.width, CV_8UC4,
-                 result_mapped_address);
-  result_buffer.unmapMemory(m_ptrContext);
+  cv::Mat result(image_size.height, image_size.width, CV_8UC4);
+  m_ptrStorageImage->copyToHost(m_ptrContext, result.data,
+                                result.total() * result.elemSize(),
+                                m_ptrStorageImageView->getImageViewInfo(),
+                                hpxc::ImageLayout::General);
   cv::cvtColor(result, result, cv::COLOR_RGBA2BGR);
 
   cv::imshow("Result", result);
@@ -69,15 +70,18 @@ void samples::core::SimpleImageComputing::initializeImageResources() {
   image_sub_info.format = hpxc::ImageFormat::R8G8B8A8Unorm;
   image_sub_info.dimension = hpxc::ImageDimension::v2D;
 
-  m_ptrImage.reset(
-      new hpxc::gpu::Image(m_ptrContext, hpxc::MemoryUsage::GpuOnly,
-                           hpxc::TransferType::TransferSrcDst,
-                           {hpxc::ImageUsage::Sampled}, image_sub_info));
+  // host transfer usage is dropped if the device doesn't support it
+  m_ptrImage.reset(new hpxc::gpu::Image(
+      m_ptrContext, hpxc::MemoryUsage::GpuOnly,
+      hpxc::TransferType::TransferSrcDst,
+      {hpxc::ImageUsage::Sampled, hpxc::ImageUsage::HostTransfer},
+      image_sub_info));
 
-  m_ptrStorageImage.reset(
-      new hpxc::gpu::Image(m_ptrContext, hpxc::MemoryUsage::GpuOnly,
-                           hpxc::TransferType::TransferSrcDst,
-                           {hpxc::ImageUsage::Storage}, image_sub_info));
+  m_ptrStorageImage.reset(new hpxc::gpu::Image(
+      m_ptrContext, hpxc::MemoryUsage::GpuOnly,
+      hpxc::TransferType::TransferSrcDst,
+      {hpxc::ImageUsage::Storage, hpxc::ImageUsage::HostTransfer},
+      image_sub_info));
 
   {
     hpxc::ImageViewInfo image_view_info{};
@@ -115,11 +119,8 @@ void samples::core::SimpleImageComputing::initializeImageResources() {
 }
 
 void samples::core::SimpleImageComputing::constructShaderResources() {
-  const auto spirv_binary =
-      hpxc::io::shader::read("shaders/compute/simple_image.comp");
-
-  m_shaderModuleMap["compute"] =
-      hpxc::gpu::ShaderModule(m_ptrContext, spirv_binary);
+  m_shaderModuleMap["compute"] = hpxc::io::shader::readModule(
+      m_ptrContext, "shaders/compute/simple_image.comp");
 
   const auto description_unit =
       hpxc::gpu::DescriptionUnit(m_shaderModuleMap, {"compute"});
@@ -151,56 +152,7 @@ void samples::core::SimpleImageComputing::constructShaderResources() {
       m_ptrContext, m_shaderModuleMap.at("compute"));
 }
 
-void samples::core::SimpleImageComputing::setTransferCommands(
-    std::vector<hpxc::gpu::Buffer>& staging_buffers) {
-  const auto command_buffer = m_ptrTransferCommandDriver->getTransfer();
-
-  staging_buffers.push_back(hpxc::createStagingBufferToGPU(
-      m_ptrContext, m_image.total() * m_image.elemSize()));
-
-  auto& staging_buffer = staging_buffers.back();
-  const auto mapped_address = staging_buffer.mapMemory(m_ptrContext);
-  std::memcpy(mapped_address, m_image.data, staging_buffer.getSize());
-  staging_buffer.unmapMemory(m_ptrContext);
-
-  command_buffer.begin();
-
-  hpxc::ImageViewInfo image_view_info = m_ptrImageView->getImageViewInfo();
-
-  {
-    const auto image_barrier = hpxc::gpu::ImageBarrier(
-        *m_ptrImage, {hpxc::AccessFlag::Unknown},
-        {hpxc::AccessFlag::TransferWrite}, hpxc::ImageLayout::Undefined,
-        hpxc::ImageLayout::TransferDstOptimal, image_view_info);
-    command_buffer.setPipelineBarrier(image_barrier,
-                                      hpxc::PipelineStage::TopOfPipe,
-                                      hpxc::PipelineStage::Transfer);
-  }
-
-  command_buffer.copyBufferToImage(staging_buffer, *m_ptrImage,
-                                   hpxc::ImageLayout::TransferDstOptimal,
-                                   image_view_info);
-
-  {
-    auto image_barrier = hpxc::gpu::ImageBarrier(
-        *m_ptrImage, {hpxc::AccessFlag::TransferWrite},
-        {hpxc::AccessFlag::ShaderRead}, hpxc::ImageLayout::TransferDstOptimal,
-        hpxc::ImageLayout::TransferDstOptimal, image_view_info);
-    image_barrier.setSrcQueueFamilyIndex(
-        m_ptrTransferCommandDriver->getQueueFamilyIndex());
-    image_barrier.setDstQueueFamilyIndex(
-        m_ptrComputeCommandDriver->getQueueFamilyIndex());
-
-    command_buffer.setPipelineBarrier(image_barrier,
-                                      hpxc::PipelineStage::Transfer,
-                                      hpxc::PipelineStage::BottomOfPipe);
-  }
-
-  command_buffer.end();
-}
-
-void samples::core::SimpleImageComputing::setComputeCommands(
-    const hpxc::gpu::Buffer& staging_buffer) {
+void samples::core::SimpleImageComputing::setComputeCommands() {
   static float_t push_timer = 0.0f;
   push_timer += 0.001f;
 
@@ -208,24 +160,7 @@ void samples::core::SimpleImageComputing::setComputeCommands(
 
   command_buffer.begin();
 
-  {
-    const hpxc::ImageViewInfo image_view_info =
-        m_ptrImageView->getImageViewInfo();
-
-    auto image_barrier = hpxc::gpu::ImageBarrier(
-        *m_ptrImage, {hpxc::AccessFlag::TransferWrite},
-        {hpxc::AccessFlag::ShaderRead}, hpxc::ImageLayout::TransferDstOptimal,
-        hpxc::ImageLayout::ShaderReadOnlyOptimal, image_view_info);
-    image_barrier.setSrcQueueFamilyIndex(
-        m_ptrTransferCommandDriver->getQueueFamilyIndex());
-    image_barrier.setDstQueueFamilyIndex(
-        m_ptrComputeCommandDriver->getQueueFamilyIndex());
-
-    command_buffer.setPipelineBarrier(image_barrier,
-                                      hpxc::PipelineStage::BottomOfPipe,
-                                      hpxc::PipelineStage::ComputeShader);
-  }
-
+  // input image is already ShaderReadOnlyOptimal by copyFromHost
   const hpxc::ImageViewInfo image_view_info =
       m_ptrStorageImageView->getImageViewInfo();
   {
@@ -239,36 +174,22 @@ void samples::core::SimpleImageComputing::setComputeCommands(
                                       hpxc::PipelineStage::ComputeShader);
   }
 
-  command_buffer.pushConstants(*m_ptrComputePipeline,
-                               {hpxc::ShaderStage::Compute}, 0U, {push_timer});
+  command_buffer.pushConstants(*m_ptrComputePipeline, PushTimer{push_timer});
   command_buffer.compute(*m_ptrComputePipeline, *m_ptrDescriptorSet,
                          hpxc::ComputeWorkGroupSize{
                              m_ptrImage->getGraphicalSize().width / 4U,
                              m_ptrImage->getGraphicalSize().height / 4U, 1U});
 
+  // result is read by copyToHost
   {
     const auto image_barrier = hpxc::gpu::ImageBarrier(
         *m_ptrStorageImage, {hpxc::AccessFlag::ShaderWrite},
-        {hpxc::AccessFlag::TransferRead}, hpxc::ImageLayout::General,
+        {hpxc::AccessFlag::HostRead}, hpxc::ImageLayout::General,
         hpxc::ImageLayout::General, image_view_info);
 
     command_buffer.setPipelineBarrier(image_barrier,
                                       hpxc::PipelineStage::ComputeShader,
-                                      hpxc::PipelineStage::Transfer);
-
-    command_buffer.copyImageToBuffer(*m_ptrStorageImage, staging_buffer,
-                                     hpxc::ImageLayout::General,
-                                     image_view_info);
-  }
-
-  {
-    const auto image_barrier = hpxc::gpu::ImageBarrier(
-        *m_ptrStorageImage, {hpxc::AccessFlag::TransferRead},
-        {hpxc::AccessFlag::ShaderWrite}, hpxc::ImageLayout::General,
-        hpxc::ImageLayout::General, image_view_info);
-    command_buffer.setPipelineBarrier(image_barrier,
-                                      hpxc::PipelineStage::Transfer,
-                                      hpxc::PipelineStage::ComputeShader);
+                                      hpxc::PipelineStage::Host);
   }
 
   command_buffer.end();
@@ -22,7 +22,6 @@ class SimpleImageComputing {
   std::unique_ptr<hpxc::gpu::Sampler> m_ptrImageSampler;
 
   std::unique_ptr<hpxc::CommandDriver> m_ptrComputeCommandDriver;
-  std::unique_ptr<hpxc::CommandDriver> m_ptrTransferCommandDriver;
 
   hpxc::ShaderModuleMap m_shaderModuleMap;
 
@@ -43,9 +42,7 @@ class SimpleImageComputing {
   void initializeImageResources();
   void constructShaderResources();
 
-  void setTransferCommands(std::vector<hpxc::gpu::Buffer>& staging_buffers);
-
-  void setComputeCommands(const hpxc::gpu::Buffer& staging_buffer);
+  void setComputeCommands();
 };
 
 }  // namespace core
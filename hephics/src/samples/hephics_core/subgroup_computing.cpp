@@ -0,0 +1,261 @@
+#include "subgroup_computing.hpp"
+
+#include <format>
+#include <iostream>
+
+constexpr uint32_t ELEMENT_COUNT = 1U << 20U;
+// same as local_size_x of reduction and scan shaders
+constexpr uint32_t LOCAL_SIZE_X = 256U;
+constexpr uint32_t WORKGROUP_COUNT = ELEMENT_COUNT / LOCAL_SIZE_X;
+
+static void print_subgroup_properties(
+    const hpxc::SubgroupProperties& subgroup_properties) {
+  std::cout << std::format("subgroup size: {}", subgroup_properties.size)
+            << std::endl;
+  std::cout << std::format(
+                   "supported stages: {}",
+                   vk::to_string(subgroup_properties.supported_stages))
+            << std::endl;
+  std::cout << std::format(
+                   "supported operations: {}",
+                   vk::to_string(subgroup_properties.supported_operations))
+            << std::endl;
+
+  if (subgroup_properties.size_control) {
+    std::cout << std::format("subgroup size range: [{}, {}]",
+                             subgroup_properties.min_size,
+                             subgroup_properties.max_size)
+              << std::endl;
+  }
+}
+
+static void set_storage_barrier(
+    const hpxc::ComputeCommandBuffer& command_buffer,
+    const hpxc::gpu::Buffer& buffer,
+    const std::vector<hpxc::AccessFlag>& src_access_flags,
+    const std::vector<hpxc::AccessFlag>& dst_access_flags,
+    const hpxc::PipelineStage src_stage, const hpxc::PipelineStage dst_stage) {
+  const auto buffer_barrier =
+      hpxc::gpu::BufferBarrier(buffer, src_access_flags, dst_access_flags);
+
+  command_buffer.setPipelineBarrier(buffer_barrier, src_stage, dst_stage);
+}
+
+samples::core::SubgroupComputing::SubgroupComputing() {
+  m_ptrContext = std::make_unique<hpxc::gpu::Context>(nullptr);
+
+  m_ptrComputeCommandDriver.reset(
+      new hpxc::CommandDriver(m_ptrContext, hpxc::QueueFamilyType::Compute));
+
+  m_ptrInputStorageBuffer.reset(hpxc::createPtrStorageBuffer(
+      m_ptrContext, hpxc::TransferType::TransferDst,
+      sizeof(float_t) * ELEMENT_COUNT));
+  m_ptrReductionStorageBuffer.reset(hpxc::createPtrStorageBuffer(
+      m_ptrContext, hpxc::TransferType::TransferSrc,
+      sizeof(float_t) * WORKGROUP_COUNT));
+  m_ptrScanStorageBuffer.reset(hpxc::createPtrStorageBuffer(
+      m_ptrContext, hpxc::TransferType::TransferSrc,
+      sizeof(float_t) * ELEMENT_COUNT));
+  m_ptrBlockSumStorageBuffer.reset(hpxc::createPtrStorageBuffer(
+      m_ptrContext, hpxc::TransferType::TransferSrc,
+      sizeof(float_t) * WORKGROUP_COUNT));
+}
+
+samples::core::SubgroupComputing::~SubgroupComputing() {
+  m_ptrContext->getDevice()->waitIdle();
+}
+
+void samples::core::SubgroupComputing::run() {
+  print_subgroup_properties(
+      m_ptrContext->getDevice()->getSubgroupProperties());
+
+  constructShaderResources();
+
+  const auto input_staging_buffer = hpxc::createStagingBufferToGPU(
+      m_ptrContext, m_ptrInputStorageBuffer->getSize());
+  const auto input_mapped_address =
+      input_staging_buffer.mapMemory(m_ptrContext);
+  std::fill_n(reinterpret_cast<float_t*>(input_mapped_address), ELEMENT_COUNT,
+              1.0f);
+  input_staging_buffer.unmapMemory(m_ptrContext);
+
+  const auto reduction_staging_buffer = hpxc::createStagingBufferFromGPU(
+      m_ptrContext, m_ptrReductionStorageBuffer->getSize());
+  const auto scan_staging_buffer = hpxc::createStagingBufferFromGPU(
+      m_ptrContext, m_ptrScanStorageBuffer->getSize());
+
+  setComputeCommands(input_staging_buffer, reduction_staging_buffer,
+                     scan_staging_buffer);
+
+  hpxc::gpu::Semaphore semaphore(m_ptrContext);
+  m_ptrComputeCommandDriver->submit(hpxc::PipelineStage::ComputeShader,
+                                    semaphore);
+  semaphore.wait(m_ptrContext);
+
+  {
+    const auto mapped_address =
+        reduction_staging_buffer.mapMemory(m_ptrContext);
+    const auto partial_sums = reinterpret_cast<const float_t*>(mapped_address);
+
+    double_t sum = 0.0;
+    for (uint32_t idx = 0U; idx < WORKGROUP_COUNT; idx += 1U) {
+      sum += partial_sums[idx];
+    }
+    reduction_staging_buffer.unmapMemory(m_ptrContext);
+
+    std::cout << std::format("reduction: {} (expected: {})", sum,
+                             ELEMENT_COUNT)
+              << std::endl;
+  }
+
+  {
+    const auto mapped_address = scan_staging_buffer.mapMemory(m_ptrContext);
+    const auto prefix_sums = reinterpret_cast<const float_t*>(mapped_address);
+
+    uint32_t error_count = 0U;
+    for (uint32_t idx = 0U; idx < ELEMENT_COUNT; idx += 1U) {
+      const auto expected = static_cast<float_t>(idx % LOCAL_SIZE_X + 1U);
+      if (prefix_sums[idx] != expected) {
+        error_count += 1U;
+      }
+    }
+    scan_staging_buffer.unmapMemory(m_ptrContext);
+
+    std::cout << std::format("scan: {} errors", error_count) << std::endl;
+  }
+
+  m_ptrComputeCommandDriver->resetAllCommandPools(m_ptrContext);
+}
+
+void samples::core::SubgroupComputing::constructShaderResources() {
+  const auto& ptr_device = m_ptrContext->getDevice();
+  const auto& subgroup_properties = ptr_device->getSubgroupProperties();
+
+  const auto use_subgroup =
+      ptr_device->isSubgroupSupported(vk::SubgroupFeatureFlagBits::eBasic |
+                                      vk::SubgroupFeatureFlagBits::eArithmetic);
+  const std::string variant = use_subgroup ? "subgroup" : "shared";
+  std::cout << std::format("kernel variant: {}", variant) << std::endl;
+
+  const auto reduction_path =
+      std::format("shaders/compute/reduction_{}.comp", variant);
+  const auto scan_path = std::format("shaders/compute/scan_{}.comp", variant);
+  constexpr auto optimization = hpxc::io::shader::Optimization::Performance;
+
+  // compile both in parallel, then readModule takes them from the cache
+  for (auto& spirv_binary : hpxc::io::shader::readMany(
+           {reduction_path, scan_path}, 0U, optimization)) {
+    spirv_binary.get();
+  }
+
+  m_shaderModuleMap["reduction"] =
+      hpxc::io::shader::readModule(m_ptrContext, reduction_path, optimization);
+  m_shaderModuleMap["scan"] =
+      hpxc::io::shader::readModule(m_ptrContext, scan_path, optimization);
+
+  const auto reduction_unit =
+      hpxc::gpu::DescriptionUnit(m_shaderModuleMap, {"reduction"});
+  const auto scan_unit =
+      hpxc::gpu::DescriptionUnit(m_shaderModuleMap, {"scan"});
+
+  m_ptrReductionSetLayout.reset(
+      new hpxc::gpu::DescriptorSetLayout(m_ptrContext, reduction_unit));
+  m_ptrScanSetLayout.reset(
+      new hpxc::gpu::DescriptorSetLayout(m_ptrContext, scan_unit));
+
+  m_ptrReductionDescriptorSet.reset(
+      new hpxc::gpu::DescriptorSet(m_ptrContext, *m_ptrReductionSetLayout));
+  m_ptrScanDescriptorSet.reset(
+      new hpxc::gpu::DescriptorSet(m_ptrContext, *m_ptrScanSetLayout));
+
+  {
+    std::vector<hpxc::gpu::BufferDescription> buffer_descriptions;
+    buffer_descriptions.emplace_back(
+        reduction_unit.getDescriptorInfoMap().at("Input"),
+        *m_ptrInputStorageBuffer);
+    buffer_descriptions.emplace_back(
+        reduction_unit.getDescriptorInfoMap().at("Output"),
+        *m_ptrReductionStorageBuffer);
+
+    m_ptrReductionDescriptorSet->updateDescriptorSet(
+        m_ptrContext, buffer_descriptions, {});
+  }
+
+  {
+    // update template path: one packed slot per binding
+    std::vector<hpxc::DescriptorUpdateInfo> update_infos(
+        m_ptrScanSetLayout->getUpdateSlotCount());
+    update_infos.at(m_ptrScanSetLayout->getUpdateSlot("Input")).buffer_info =
+        vk::DescriptorBufferInfo(m_ptrInputStorageBuffer->getBuffer(), 0U,
+                                 m_ptrInputStorageBuffer->getSize());
+    update_infos.at(m_ptrScanSetLayout->getUpdateSlot("Output")).buffer_info =
+        vk::DescriptorBufferInfo(m_ptrScanStorageBuffer->getBuffer(), 0U,
+                                 m_ptrScanStorageBuffer->getSize());
+    update_infos.at(m_ptrScanSetLayout->getUpdateSlot("BlockSums"))
+        .buffer_info =
+        vk::DescriptorBufferInfo(m_ptrBlockSumStorageBuffer->getBuffer(), 0U,
+                                 m_ptrBlockSumStorageBuffer->getSize());
+
+    m_ptrScanDescriptorSet->updateDescriptorSet(
+        m_ptrContext, *m_ptrScanSetLayout, update_infos);
+  }
+
+  m_ptrReductionPipeline.reset(new hpxc::gpu::Pipeline(
+      m_ptrContext, reduction_unit, *m_ptrReductionSetLayout));
+  m_ptrScanPipeline.reset(
+      new hpxc::gpu::Pipeline(m_ptrContext, scan_unit, *m_ptrScanSetLayout));
+
+  // the widest subgroup makes the shared memory step shortest
+  if (use_subgroup && subgroup_properties.size_control &&
+      (subgroup_properties.required_size_stages &
+       vk::ShaderStageFlagBits::eCompute)) {
+    m_ptrReductionPipeline->setRequiredSubgroupSize(
+        m_ptrContext, subgroup_properties.max_size);
+    m_ptrScanPipeline->setRequiredSubgroupSize(m_ptrContext,
+                                               subgroup_properties.max_size);
+  }
+
+  hpxc::gpu::ComputePipelineBuilder pipeline_builder;
+  pipeline_builder.add(*m_ptrReductionPipeline,
+                       m_shaderModuleMap.at("reduction"));
+  pipeline_builder.add(*m_ptrScanPipeline, m_shaderModuleMap.at("scan"));
+  pipeline_builder.build(m_ptrContext);
+}
+
+void samples::core::SubgroupComputing::setComputeCommands(
+    const hpxc::gpu::Buffer& input_staging_buffer,
+    const hpxc::gpu::Buffer& reduction_staging_buffer,
+    const hpxc::gpu::Buffer& scan_staging_buffer) {
+  const auto command_buffer = m_ptrComputeCommandDriver->getCompute();
+
+  command_buffer.begin();
+
+  command_buffer.copyBuffer(input_staging_buffer, *m_ptrInputStorageBuffer);
+  set_storage_barrier(command_buffer, *m_ptrInputStorageBuffer,
+                      {hpxc::AccessFlag::TransferWrite},
+                      {hpxc::AccessFlag::ShaderRead},
+                      hpxc::PipelineStage::Transfer,
+                      hpxc::PipelineStage::ComputeShader);
+
+  command_buffer.compute(*m_ptrReductionPipeline, *m_ptrReductionDescriptorSet,
+                         hpxc::ComputeWorkGroupSize{WORKGROUP_COUNT, 1U, 1U});
+  command_buffer.compute(*m_ptrScanPipeline, *m_ptrScanDescriptorSet,
+                         hpxc::ComputeWorkGroupSize{WORKGROUP_COUNT, 1U, 1U});
+
+  set_storage_barrier(command_buffer, *m_ptrReductionStorageBuffer,
+                      {hpxc::AccessFlag::ShaderWrite},
+                      {hpxc::AccessFlag::TransferRead},
+                      hpxc::PipelineStage::ComputeShader,
+                      hpxc::PipelineStage::Transfer);
+  set_storage_barrier(command_buffer, *m_ptrScanStorageBuffer,
+                      {hpxc::AccessFlag::ShaderWrite},
+                      {hpxc::AccessFlag::TransferRead},
+                      hpxc::PipelineStage::ComputeShader,
+                      hpxc::PipelineStage::Transfer);
+
+  command_buffer.copyBuffer(*m_ptrReductionStorageBuffer,
+                            reduction_staging_buffer);
+  command_buffer.copyBuffer(*m_ptrScanStorageBuffer, scan_staging_buffer);
+
+  command_buffer.end();
+}
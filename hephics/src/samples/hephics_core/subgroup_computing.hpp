@@ -0,0 +1,52 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../../hephics_core.hpp"
+
+namespace samples {
+namespace core {
+
+/// <summary>
+/// Reduction and scan with subgroup arithmetic,
+///   or with shared memory when subgroup arithmetic is not supported.
+/// </summary>
+class SubgroupComputing {
+ private:
+  std::unique_ptr<hpxc::gpu::Context> m_ptrContext;
+
+  std::unique_ptr<hpxc::CommandDriver> m_ptrComputeCommandDriver;
+
+  std::unique_ptr<hpxc::gpu::Buffer> m_ptrInputStorageBuffer;
+  std::unique_ptr<hpxc::gpu::Buffer> m_ptrReductionStorageBuffer;
+  std::unique_ptr<hpxc::gpu::Buffer> m_ptrScanStorageBuffer;
+  std::unique_ptr<hpxc::gpu::Buffer> m_ptrBlockSumStorageBuffer;
+
+  hpxc::ShaderModuleMap m_shaderModuleMap;
+
+  std::unique_ptr<hpxc::gpu::DescriptorSetLayout> m_ptrReductionSetLayout;
+  std::unique_ptr<hpxc::gpu::DescriptorSetLayout> m_ptrScanSetLayout;
+
+  std::unique_ptr<hpxc::gpu::DescriptorSet> m_ptrReductionDescriptorSet;
+  std::unique_ptr<hpxc::gpu::DescriptorSet> m_ptrScanDescriptorSet;
+  std::unique_ptr<hpxc::gpu::Pipeline> m_ptrReductionPipeline;
+  std::unique_ptr<hpxc::gpu::Pipeline> m_ptrScanPipeline;
+
+ public:
+  SubgroupComputing();
+
+  ~SubgroupComputing();
+
+  void run();
+
+ private:
+  void constructShaderResources();
+  void setComputeCommands(const hpxc::gpu::Buffer& input_staging_buffer,
+                          const hpxc::gpu::Buffer& reduction_staging_buffer,
+                          const hpxc::gpu::Buffer& scan_staging_buffer);
+};
+
+}  // namespace core
+}  // namespace samples